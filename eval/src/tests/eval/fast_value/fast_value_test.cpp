@@ -140,6 +140,65 @@ TEST(FastValueTest, insert_empty_subspace) {
     EXPECT_EQ(actual, expected);
 }
 
+TEST(FastValueTest, index_tracks_sorted_addresses) {
+    auto type = ValueType::from_spec("tensor<float>(x{},y{})");
+    auto value = std::make_unique<FastValue<float,true>>(type, 2, 1, 4);
+    const auto &map = as_fast(value->index()).map;
+    auto add = [&](uint32_t a, uint32_t b) {
+        std::vector<string_id> addr{Handle::handle_from_number(a).id(), Handle::handle_from_number(b).id()};
+        value->add_subspace(addr)[0] = 1.0;
+    };
+    EXPECT_TRUE(map.is_sorted());
+    add(1, 5);
+    EXPECT_TRUE(map.is_sorted());
+    add(2, 3);
+    add(2, 4);
+    EXPECT_TRUE(map.is_sorted());
+    add(2, 3);
+    EXPECT_FALSE(map.is_sorted());
+    add(3, 1);
+    EXPECT_FALSE(map.is_sorted());
+}
+
+std::unique_ptr<FastValue<float,true>> make_value(const std::vector<uint32_t> &labels) {
+    auto value = std::make_unique<FastValue<float,true>>(ValueType::from_spec("tensor<float>(x{})"), 1, 1, labels.size());
+    for (uint32_t label: labels) {
+        value->add_singledim_mapping(Handle::handle_from_number(label).id());
+        value->my_cells.push_back_fast(label);
+    }
+    return value;
+}
+
+TEST(FastValueTest, sorted_indexes_can_be_merged) {
+    auto a = make_value({1, 3, 4, 7, 9, 10});
+    auto b = make_value({2, 3, 5, 7, 10, 12});
+    const auto &a_map = as_fast(a->index()).map;
+    const auto &b_map = as_fast(b->index()).map;
+    ASSERT_TRUE(a_map.is_sorted());
+    ASSERT_TRUE(b_map.is_sorted());
+    EXPECT_TRUE(FastAddrMap::should_merge(a_map, b_map));
+    std::vector<std::pair<size_t,size_t>> matches;
+    FastAddrMap::merge(a_map, b_map, [&](size_t a_subspace, size_t b_subspace) {
+                matches.emplace_back(a_subspace, b_subspace);
+            });
+    std::vector<std::pair<size_t,size_t>> expect({{1,1}, {3,3}, {5,4}});
+    EXPECT_EQ(matches, expect);
+}
+
+TEST(FastValueTest, unsorted_or_unbalanced_indexes_are_not_merged) {
+    auto sorted = make_value({1, 2, 3});
+    auto unsorted = make_value({3, 2, 1});
+    std::vector<uint32_t> many;
+    for (uint32_t i = 1; i <= 100; ++i) {
+        many.push_back(i);
+    }
+    auto big = make_value(many);
+    EXPECT_FALSE(as_fast(unsorted->index()).map.is_sorted());
+    EXPECT_FALSE(FastAddrMap::should_merge(as_fast(sorted->index()).map, as_fast(unsorted->index()).map));
+    EXPECT_FALSE(FastAddrMap::should_merge(as_fast(sorted->index()).map, as_fast(big->index()).map));
+    EXPECT_TRUE(FastAddrMap::should_merge(as_fast(big->index()).map, as_fast(big->index()).map));
+}
+
 void
 verifyFastValueSize(TensorSpec spec, uint32_t elems, size_t expected) {
     for (uint32_t i=0; i < elems; i++) {
@@ -150,9 +209,9 @@ verifyFastValueSize(TensorSpec spec, uint32_t elems, size_t expected) {
 }
 
 TEST(FastValueTest, document_fast_value_memory_usage) {
-    EXPECT_EQ(232, sizeof(FastValue<float,true>));
+    EXPECT_EQ(240, sizeof(FastValue<float,true>));
     FastValue<float,true> test(ValueType::from_spec("tensor<float>(country{})"), 1, 1, 1);
-    constexpr size_t BASE_SZ = 348 + sizeof(std::string);
+    constexpr size_t BASE_SZ = 356 + sizeof(std::string);
     EXPECT_EQ(BASE_SZ, test.get_memory_usage().allocatedBytes());
 
 
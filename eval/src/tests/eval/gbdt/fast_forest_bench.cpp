@@ -23,6 +23,19 @@ void estimate_cost(size_t num_params, const char *label, const T &impl) {
             label, (us_min / 10.0), (us_med / 10.0), (us_max / 10.0), (us_nan / 10.0));
 }
 
+void estimate_batch_cost(size_t num_params, const char *label, const FastForest &forest) {
+    std::vector<double> inputs_min(num_params, 0.25);
+    std::vector<double> inputs_med(num_params, 0.50);
+    std::vector<double> inputs_max(num_params, 0.75);
+    std::vector<double> inputs_nan(num_params, std::numeric_limits<double>::quiet_NaN());
+    double us_min = forest.estimate_batch_cost_us(inputs_min, 64, 5.0);
+    double us_med = forest.estimate_batch_cost_us(inputs_med, 64, 5.0);
+    double us_max = forest.estimate_batch_cost_us(inputs_max, 64, 5.0);
+    double us_nan = forest.estimate_batch_cost_us(inputs_nan, 64, 5.0);
+    fprintf(stderr, "[%12s] (per 100 eval): [low values] %6.3f ms, [medium values] %6.3f ms, [high values] %6.3f ms, [nan values] %6.3f ms\n",
+            label, (us_min / 10.0), (us_med / 10.0), (us_max / 10.0), (us_nan / 10.0));
+}
+
 void run_fast_forest_bench() {
     for (size_t tree_size: std::vector<size_t>({8,16,32,64,128,256})) {
         for (size_t num_trees: std::vector<size_t>({100, 500, 2500, 5000, 10000})) {
@@ -36,6 +49,7 @@ void run_fast_forest_bench() {
                             auto forest = FastForest::try_convert(*function, min_bits, 64);
                             if (forest) {
                                 estimate_cost(function->num_params(), forest->impl_name().c_str(), *forest);
+                                estimate_batch_cost(function->num_params(), (forest->impl_name() + " x64").c_str(), *forest);
                             }
                             if (min_bits > 64) {
                                 break;
@@ -10,6 +10,9 @@
 #include <vespa/eval/eval/test/eval_spec.h>
 #include <vespa/eval/eval/basic_nodes.h>
 #include <vespa/eval/eval/simple_value.h>
+#include <vespa/eval/eval/value_codec.h>
+#include <vespa/eval/eval/test/gen_spec.h>
+#include <vespa/vespalib/util/arena_memory_allocator.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/stash.h>
 #include <vespa/vespalib/test/insertion_operators.h>
@@ -150,6 +153,42 @@ TEST("require that basic addition works") {
 
 //-----------------------------------------------------------------------------
 
+TEST("require that intermediate tensor cells are allocated from the context arena") {
+    auto function = Function::parse({"a", "b"}, "reduce(a*b,sum,y)");
+    auto a = value_from_spec(test::GenSpec().map("x", 8, 1).idx("y", 3), FastValueBuilderFactory::get());
+    auto b = value_from_spec(test::GenSpec().idx("y", 3).map("z", 8, 2), FastValueBuilderFactory::get());
+    auto node_types = NodeTypes(*function, {a->type(), b->type()});
+    InterpretedFunction ifun(FastValueBuilderFactory::get(), *function, node_types);
+    InterpretedFunction::Context ctx(ifun);
+    SimpleObjectParams params({*a, *b});
+    auto expect = spec_from_value(ifun.eval(ctx, params));
+    auto stats = ctx.arena().get_stats();
+    EXPECT_GREATER(stats.allocations, 0u);
+    EXPECT_EQUAL(stats.block_allocations, 1u);
+    for (size_t i = 0; i < 10; ++i) {
+        EXPECT_EQUAL(spec_from_value(ifun.eval(ctx, params)), expect);
+    }
+    EXPECT_EQUAL(ctx.arena().get_stats().allocations, 11 * stats.allocations);
+    EXPECT_EQUAL(ctx.arena().get_stats().block_allocations, 1u);
+}
+
+TEST("require that context arena keeps at most its retain limit between evaluations") {
+    auto function = Function::parse({"a", "b"}, "reduce(a*b,sum,y)");
+    auto a = value_from_spec(test::GenSpec().map("x", 8, 1).idx("y", 3), FastValueBuilderFactory::get());
+    auto b = value_from_spec(test::GenSpec().idx("y", 3).map("z", 8, 2), FastValueBuilderFactory::get());
+    auto node_types = NodeTypes(*function, {a->type(), b->type()});
+    InterpretedFunction ifun(FastValueBuilderFactory::get(), *function, node_types);
+    InterpretedFunction::Context ctx(ifun, 0);
+    SimpleObjectParams params({*a, *b});
+    auto expect = spec_from_value(ifun.eval(ctx, params));
+    EXPECT_GREATER(ctx.arena().capacity(), 0u);
+    auto usage = ctx.get_memory_usage();
+    EXPECT_GREATER_EQUAL(usage.allocatedBytes(), ctx.arena().capacity());
+    EXPECT_GREATER_EQUAL(usage.usedBytes(), ctx.arena().get_memory_usage().usedBytes());
+    EXPECT_EQUAL(spec_from_value(ifun.eval(ctx, params)), expect);
+    EXPECT_EQUAL(ctx.arena().get_stats().block_allocations, 2u);
+}
+
 TEST("require that functions with non-compilable simple lambdas cannot be interpreted") {
     auto good_map = Function::parse("map(a,f(x)(x+1))");
     auto good_join = Function::parse("join(a,b,f(x,y)(x+y))");
@@ -4,9 +4,16 @@
 #include <vespa/eval/eval/value_cache/constant_value.h>
 #include <vespa/eval/eval/value.h>
 #include <vespa/eval/eval/value_type.h>
+#include <vespa/eval/eval/tensor_spec.h>
+#include <filesystem>
+#include <fstream>
 
 using namespace vespalib::eval;
 
+void write_file(const std::string &name, const std::string &content) {
+    std::ofstream(name) << content;
+}
+
 struct MyValue : ConstantValue {
     DoubleValue my_value;
     ValueType my_type;
@@ -67,4 +74,51 @@ TEST_FF("require that type spec is part of cache key", MyFactory(), ConstantValu
     EXPECT_EQUAL(3u, f1.create_cnt);
 }
 
+TEST_FF("require that files with the same content share values", MyFactory(), ConstantValueCache(f1)) {
+    write_file("value_a.json", "[1,2,3]");
+    write_file("value_b.json", "[1,2,3]");
+    write_file("value_c.json", "[1,2,4]");
+    auto res1 = f2.create("value_a.json", "type");
+    auto res2 = f2.create("value_b.json", "type");
+    auto res3 = f2.create("value_c.json", "type");
+    auto res4 = f2.create("value_b.json", "other_type");
+    EXPECT_EQUAL(&res1->value(), &res2->value());
+    EXPECT_NOT_EQUAL(&res1->value(), &res3->value());
+    EXPECT_EQUAL(3u, f1.create_cnt);
+    EXPECT_EQUAL(3u, f2.num_cached());
+    std::filesystem::remove("value_a.json");
+    std::filesystem::remove("value_b.json");
+    std::filesystem::remove("value_c.json");
+}
+
+TEST_FF("require that a changed file is not shared with its old content", MyFactory(), ConstantValueCache(f1)) {
+    write_file("value_d.json", "[1,2,3]");
+    auto res1 = f2.create("value_d.json", "type");
+    auto res2 = f2.create("value_d.json", "type");
+    write_file("value_d.json", "[1,2,3,4]");
+    auto res3 = f2.create("value_d.json", "type");
+    EXPECT_EQUAL(&res1->value(), &res2->value());
+    EXPECT_NOT_EQUAL(&res1->value(), &res3->value());
+    EXPECT_EQUAL(2u, f1.create_cnt);
+    std::filesystem::remove("value_d.json");
+}
+
+TEST("require that tensors loaded through the shared tensor cache are shared") {
+    write_file("tensor_a.json", "[1,2,3]");
+    write_file("tensor_b.json", "[1,2,3]");
+    const auto &cache = ConstantValueCache::shared_tensor_cache();
+    EXPECT_EQUAL(&cache, &ConstantValueCache::shared_tensor_cache());
+    auto res1 = cache.create("tensor_a.json", "tensor(x[3])");
+    auto res2 = ConstantValueCache::shared_tensor_cache().create("tensor_b.json", "tensor(x[3])");
+    EXPECT_EQUAL(&res1->value(), &res2->value());
+    EXPECT_EQUAL(1u, cache.num_cached());
+    auto expect = TensorSpec("tensor(x[3])").add({{"x", 0}}, 1.0).add({{"x", 1}}, 2.0).add({{"x", 2}}, 3.0);
+    EXPECT_EQUAL(expect, TensorSpec::from_value(res2->value()));
+    res1.reset();
+    res2.reset();
+    EXPECT_EQUAL(0u, cache.num_cached());
+    std::filesystem::remove("tensor_a.json");
+    std::filesystem::remove("tensor_b.json");
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
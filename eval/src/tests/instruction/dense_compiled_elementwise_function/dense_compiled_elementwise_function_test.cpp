@@ -0,0 +1,113 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/eval/eval/tensor_function.h>
+#include <vespa/eval/eval/function.h>
+#include <vespa/eval/instruction/dense_compiled_elementwise_function.h>
+#include <vespa/eval/instruction/l2_distance.h>
+#include <vespa/eval/eval/test/eval_fixture.h>
+#include <vespa/eval/eval/test/gen_spec.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::eval::test;
+
+constexpr size_t npos = DenseCompiledElementwiseFunction::Self::npos;
+
+struct FunInfo {
+    using LookFor = DenseCompiledElementwiseFunction;
+    size_t num_ops;
+    size_t num_children;
+    size_t inplace_param;
+    bool debug_dump;
+    void verify(const EvalFixture &fixture, const LookFor &fun) const {
+        EXPECT_TRUE(fun.result_is_mutable());
+        EXPECT_EQ(fun.num_ops(), num_ops);
+        std::vector<TensorFunction::Child::CREF> children;
+        fun.push_children(children);
+        EXPECT_EQ(children.size(), num_children);
+        EXPECT_EQ(fun.function().num_params(), num_children);
+        EXPECT_EQ(fun.inplace_param(), inplace_param);
+        if (inplace_param != npos) {
+            EXPECT_EQ(fixture.result_value().cells().data, fixture.param_value(inplace_param).cells().data);
+        }
+        if (debug_dump) {
+            fprintf(stderr, "%s", fun.as_string().c_str());
+        }
+    }
+};
+
+struct L2Info {
+    using LookFor = L2Distance;
+    void verify(const LookFor &) const {}
+};
+
+void verify_optimized(const std::string &expr, size_t num_ops, size_t num_children) {
+    SCOPED_TRACE(expr.c_str());
+    auto fun = Function::parse(expr);
+    CellTypeSpace all_types(CellTypeUtils::list_types(), fun->num_params());
+    EvalFixture::verify<FunInfo>(expr, {FunInfo{num_ops, num_children, npos, false}}, all_types);
+}
+
+void verify_not_optimized(const std::string &expr) {
+    SCOPED_TRACE(expr.c_str());
+    auto fun = Function::parse(expr);
+    CellTypeSpace just_double({CellType::DOUBLE}, fun->num_params());
+    EvalFixture::verify<FunInfo>(expr, {}, just_double);
+}
+
+TEST(DenseCompiledElementwiseTest, elementwise_operations_are_fused) {
+    verify_optimized("x5y3$1*x5y3$2+x5y3$3", 2, 3);
+    verify_optimized("exp(x5y3$1*x5y3$2+x5y3$3)", 3, 3);
+    verify_optimized("sqrt(fabs(x5y3$1-x5y3$2))*x5y3$3", 4, 3);
+    verify_optimized("max(x5y3$1,x5y3$2)/x5y3$1", 2, 3);
+}
+
+TEST(DenseCompiledElementwiseTest, number_operands_become_parameters) {
+    verify_optimized("x5y3$1*reduce(v3$2,sum)+1", 2, 3);
+    verify_optimized("sigmoid(x5y3$1*2)", 2, 2);
+}
+
+TEST(DenseCompiledElementwiseTest, large_tensors_are_processed_in_blocks) {
+    verify_optimized("tanh(x10y17$1-x10y17$2)", 2, 2);
+}
+
+TEST(DenseCompiledElementwiseTest, mutable_tensor_can_be_overwritten) {
+    CellTypeSpace stable_types(CellTypeUtils::list_stable_types(), 1);
+    EvalFixture::verify<FunInfo>("exp(@x5y3$1*2)", {FunInfo{2, 2, 0, false}}, stable_types);
+    CellTypeSpace unstable_types(CellTypeUtils::list_unstable_types(), 1);
+    EvalFixture::verify<FunInfo>("exp(@x5y3$1*2)", {FunInfo{2, 2, npos, false}}, unstable_types);
+}
+
+TEST(DenseCompiledElementwiseTest, single_operation_is_not_fused) {
+    verify_not_optimized("x5y3$1+x5y3$2");
+    verify_not_optimized("exp(x5y3$1)");
+}
+
+TEST(DenseCompiledElementwiseTest, operations_on_different_dimensions_are_not_fused) {
+    verify_not_optimized("x5y3$1*y3$2+1");
+    verify_not_optimized("exp(x5$1*y3$2)");
+}
+
+TEST(DenseCompiledElementwiseTest, custom_lambdas_are_not_fused) {
+    verify_not_optimized("map(x5y3$1+x5y3$2,f(a)(a*a+1))");
+    verify_not_optimized("join(x5y3$1,x5y3$2,f(a,b)(a*b+1))");
+}
+
+TEST(DenseCompiledElementwiseTest, sparse_and_mixed_operations_are_not_fused) {
+    verify_not_optimized("x3_1$1*x3_1$2+x3_1$3");
+    verify_not_optimized("exp(x3_1y5$1*x3_1y5$2)");
+}
+
+TEST(DenseCompiledElementwiseTest, specialized_patterns_are_preserved) {
+    verify_not_optimized("reduce((x5$1-x5$2)^2,sum)");
+    CellTypeSpace just_double({CellType::DOUBLE}, 2);
+    EvalFixture::verify<L2Info>("reduce((x5$1-x5$2)^2,sum)", {L2Info{}}, just_double);
+}
+
+TEST(DenseCompiledElementwiseTest, fused_function_can_be_debug_dumped) {
+    CellTypeSpace just_double({CellType::DOUBLE}, 3);
+    EvalFixture::verify<FunInfo>("exp(x5y3$1*x5y3$2+x5y3$3)", {FunInfo{3, 3, npos, true}}, just_double);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,88 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/eval/eval/tensor_function.h>
+#include <vespa/eval/eval/function.h>
+#include <vespa/eval/instruction/dense_join_map_reduce_function.h>
+#include <vespa/eval/eval/test/eval_fixture.h>
+#include <vespa/eval/eval/test/gen_spec.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::eval::test;
+
+struct FunInfo {
+    using LookFor = DenseJoinMapReduceFunction;
+    size_t num_maps;
+    Aggr aggr;
+    bool debug_dump;
+    void verify(const LookFor &fun) const {
+        EXPECT_TRUE(fun.result_is_mutable());
+        EXPECT_EQ(fun.map_funs().size(), num_maps);
+        EXPECT_EQ(fun.aggr(), aggr);
+        if (debug_dump) {
+            fprintf(stderr, "%s", fun.as_string().c_str());
+        }
+    }
+};
+
+void verify_optimized(const std::string &expr, size_t num_maps, Aggr aggr) {
+    SCOPED_TRACE(expr.c_str());
+    auto fun = Function::parse(expr);
+    CellTypeSpace all_types(CellTypeUtils::list_types(), fun->num_params());
+    EvalFixture::verify<FunInfo>(expr, {FunInfo{num_maps, aggr, false}}, all_types);
+}
+
+void verify_not_optimized(const std::string &expr) {
+    SCOPED_TRACE(expr.c_str());
+    auto fun = Function::parse(expr);
+    CellTypeSpace just_double({CellType::DOUBLE}, fun->num_params());
+    EvalFixture::verify<FunInfo>(expr, {}, just_double);
+}
+
+TEST(DenseJoinMapReduceTest, join_map_reduce_chains_are_optimized) {
+    verify_optimized("reduce(fabs(x5y3$1-x5y3$2),max,y)", 1, Aggr::MAX);
+    verify_optimized("reduce(exp(tanh(x5y3$1*x5y3$2)),sum,x)", 2, Aggr::SUM);
+    verify_optimized("reduce(map(x5y3$1-x5y3$2,f(a)(a*a+1)),min,x)", 1, Aggr::MIN);
+}
+
+TEST(DenseJoinMapReduceTest, join_reduce_without_map_is_optimized) {
+    verify_optimized("reduce(x5y3$1-x5y3$2,avg,x)", 0, Aggr::AVG);
+    verify_optimized("reduce(max(x5y3$1,x5y3$2),prod,y)", 0, Aggr::PROD);
+    verify_optimized("reduce(x5y3$1+x5y3$2,count,y)", 0, Aggr::COUNT);
+}
+
+TEST(DenseJoinMapReduceTest, join_with_expansion_is_optimized) {
+    verify_optimized("reduce(tanh(x5$1+y3$2),sum,y)", 1, Aggr::SUM);
+    verify_optimized("reduce(sigmoid(x5z2$1*y3z2$2),max,x,z)", 1, Aggr::MAX);
+}
+
+TEST(DenseJoinMapReduceTest, full_reduce_is_optimized) {
+    verify_optimized("reduce(fabs(x5y3$1-x5y3$2),max)", 1, Aggr::MAX);
+    verify_optimized("reduce(x5y3$1-y3$2,sum,x,y)", 0, Aggr::SUM);
+}
+
+TEST(DenseJoinMapReduceTest, median_is_not_optimized) {
+    verify_not_optimized("reduce(x5y3$1-x5y3$2,median,y)");
+}
+
+TEST(DenseJoinMapReduceTest, join_with_number_is_not_optimized) {
+    verify_not_optimized("reduce(exp(x5y3$1*2),sum,y)");
+}
+
+TEST(DenseJoinMapReduceTest, sparse_and_mixed_chains_are_not_optimized) {
+    verify_not_optimized("reduce(fabs(x3_1$1-x3_1$2),max)");
+    verify_not_optimized("reduce(fabs(x3_1y5$1-x3_1y5$2),max,y)");
+}
+
+TEST(DenseJoinMapReduceTest, dot_products_are_left_for_more_specific_optimizers) {
+    verify_not_optimized("reduce(x5$1*x5$2,sum)");
+    verify_not_optimized("reduce(x5y3$1*y3$2,sum,y)");
+}
+
+TEST(DenseJoinMapReduceTest, join_map_reduce_can_be_debug_dumped) {
+    CellTypeSpace just_double({CellType::DOUBLE}, 2);
+    EvalFixture::verify<FunInfo>("reduce(fabs(x5y3$1-x5y3$2),max,y)", {FunInfo{1, Aggr::MAX, true}}, just_double);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
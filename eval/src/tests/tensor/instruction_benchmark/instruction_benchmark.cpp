@@ -107,6 +107,16 @@ Instruction compile_op1_chain(const TensorFunction &node, const ValueBuilderFact
     return {my_multi_instruction_op,(uint64_t)(&param)};
 }
 
+// like compile_op1_chain, but also including the node ending the chain
+Instruction compile_op_chain(const TensorFunction &node, const ValueBuilderFactory &factory, Stash &stash) {
+    auto &param = stash.create<MultiOpParam>();
+    if (auto op1 = as<tensor_function::Op1>(node)) {
+        collect_op1_chain(op1->child(), factory, stash, param.list);
+    }
+    param.list.push_back(node.compile_self(factory, stash));
+    return {my_multi_instruction_op,(uint64_t)(&param)};
+}
+
 //-----------------------------------------------------------------------------
 
 struct Impl {
@@ -137,6 +147,22 @@ struct Impl {
         // instructions into a single compound instruction.
         return compile_op1_chain(node, factory, stash);
     }
+    Instruction create_join_map_reduce(const ValueType &lhs, const ValueType &rhs, operation::op2_t join_fun,
+                                       const std::vector<operation::op1_t> &map_funs, Aggr aggr,
+                                       const std::vector<std::string> &dims, Stash &stash) const
+    {
+        // create a complete tensor function, and compile all of it
+        // except the parameters into a single compound instruction.
+        const auto &lhs_node = tensor_function::inject(lhs, 0, stash);
+        const auto &rhs_node = tensor_function::inject(rhs, 1, stash);
+        const TensorFunction *chain_node = &tensor_function::join(lhs_node, rhs_node, join_fun, stash);
+        for (auto map_fun: map_funs) {
+            chain_node = &tensor_function::map(*chain_node, map_fun, stash);
+        }
+        const auto &reduce_node = tensor_function::reduce(*chain_node, aggr, dims, stash);
+        const auto &node = optimize ? optimize_tensor_function(factory, reduce_node, stash) : reduce_node;
+        return compile_op_chain(node, factory, stash);
+    }
     Instruction create_rename(const ValueType &lhs, const std::vector<std::string> &from, const std::vector<std::string> &to, Stash &stash) const {
         // create a complete tensor function, but only compile the relevant instruction
         const auto &lhs_node = tensor_function::inject(lhs, 0, stash);
@@ -503,6 +529,29 @@ void benchmark_reduce(const std::string &desc, const TensorSpec &lhs,
 
 //-----------------------------------------------------------------------------
 
+void benchmark_join_map_reduce(const std::string &desc, const TensorSpec &lhs, const TensorSpec &rhs,
+                               operation::op2_t join_fun, const std::vector<operation::op1_t> &map_funs,
+                               Aggr aggr, const std::vector<std::string> &dims)
+{
+    Stash stash;
+    ValueType lhs_type = ValueType::from_spec(lhs.type());
+    ValueType rhs_type = ValueType::from_spec(rhs.type());
+    ValueType res_type = ValueType::join(lhs_type, rhs_type).reduce(dims);
+    ASSERT_FALSE(lhs_type.is_error());
+    ASSERT_FALSE(rhs_type.is_error());
+    ASSERT_FALSE(res_type.is_error());
+    std::vector<EvalOp::UP> list;
+    for (const Impl &impl: impl_list) {
+        Stash my_stash;
+        auto op = impl.create_join_map_reduce(lhs_type, rhs_type, join_fun, map_funs, aggr, dims, my_stash);
+        std::vector<CREF<TensorSpec>> stack_spec({lhs, rhs});
+        list.push_back(std::make_unique<EvalOp>(std::move(my_stash), op, stack_spec, impl));
+    }
+    benchmark(desc, list);
+}
+
+//-----------------------------------------------------------------------------
+
 void benchmark_rename(const std::string &desc, const TensorSpec &lhs,
                       const std::vector<std::string> &from,
                       const std::vector<std::string> &to)
@@ -934,6 +983,28 @@ TEST(ReduceBench, mixed_reduce) {
 
 //-----------------------------------------------------------------------------
 
+TEST(JoinMapReduceBench, dense_join_map_reduce) {
+    auto lhs = GS(1.0).idx("a", 16).idx("b", 16).idx("c", 16);
+    auto rhs = GS(2.0).idx("a", 16).idx("b", 16).idx("c", 16);
+    benchmark_join_map_reduce("dense sub abs max inner", lhs, rhs, operation::Sub::f,
+                              {operation::Fabs::f}, Aggr::MAX, {"c"});
+    benchmark_join_map_reduce("dense mul tanh exp sum outer", lhs, rhs, operation::Mul::f,
+                              {operation::Tanh::f, operation::Exp::f}, Aggr::SUM, {"a"});
+    benchmark_join_map_reduce("dense add relu sum all", lhs, rhs, operation::Add::f,
+                              {operation::Relu::f}, Aggr::SUM, {});
+}
+
+TEST(JoinMapReduceBench, dense_expand_map_reduce) {
+    auto lhs = GS(1.0).idx("a", 64).idx("c", 8);
+    auto rhs = GS(2.0).idx("b", 64).idx("c", 8);
+    benchmark_join_map_reduce("dense expand mul sigmoid sum", lhs, rhs, operation::Mul::f,
+                              {operation::Sigmoid::f}, Aggr::SUM, {"c"});
+    benchmark_join_map_reduce("dense expand sub square max", lhs, rhs, operation::Sub::f,
+                              {operation::Square::f}, Aggr::MAX, {"b"});
+}
+
+//-----------------------------------------------------------------------------
+
 TEST(RenameBench, dense_rename) {
     auto lhs = GS(1.0).idx("a", 64).idx("b", 64);
     benchmark_rename("dense transpose", lhs, {"a", "b"}, {"b", "a"});
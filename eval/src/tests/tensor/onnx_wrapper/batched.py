@@ -0,0 +1,42 @@
+# Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+import onnx
+from onnx import helper, TensorProto
+
+IN1 = helper.make_tensor_value_info('in1', TensorProto.FLOAT, ['batch', 3])
+IN2 = helper.make_tensor_value_info('in2', TensorProto.DOUBLE, ['batch', 3])
+OUT1 = helper.make_tensor_value_info('sum', TensorProto.FLOAT, ['batch', 3])
+OUT2 = helper.make_tensor_value_info('dot', TensorProto.FLOAT, ['batch', 1])
+
+nodes = [
+    helper.make_node(
+        'Cast',
+        ['in2'],
+        ['in2_float'],
+        to=TensorProto.FLOAT,
+    ),
+    helper.make_node(
+        'Add',
+        ['in1', 'in2_float'],
+        ['sum'],
+    ),
+    helper.make_node(
+        'Mul',
+        ['in1', 'in2_float'],
+        ['prod'],
+    ),
+    helper.make_node(
+        'ReduceSum',
+        ['prod'],
+        ['dot'],
+        axes=[1],
+    ),
+]
+graph_def = helper.make_graph(
+    nodes,
+    'batched',
+    [IN1, IN2],
+    [OUT1, OUT2],
+)
+model_def = helper.make_model(graph_def, producer_name='batched.py', opset_imports=[onnx.OperatorSetIdProto(version=12)])
+model_def.ir_version = 7
+onnx.save(model_def, 'batched.onnx')
@@ -0,0 +1,28 @@
+# Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+import numpy as np
+import onnx
+from onnx import helper, numpy_helper, TensorProto
+
+INPUT = helper.make_tensor_value_info('in', TensorProto.FLOAT, [1, 4])
+OUTPUT = helper.make_tensor_value_info('out', TensorProto.FLOAT, [1, 4])
+
+nodes = [
+    helper.make_node(
+        'Add',
+        ['in', 'bias'],
+        ['out'],
+    ),
+]
+bias = numpy_helper.from_array(np.array([[1.0, 2.0, 3.0, 4.0]], dtype=np.float32), name='bias')
+graph_def = helper.make_graph(
+    nodes,
+    'external_data',
+    [INPUT],
+    [OUTPUT],
+    [bias],
+)
+
+model_def = helper.make_model(graph_def, producer_name='external_data.py', opset_imports=[onnx.OperatorSetIdProto(version=12)])
+model_def.ir_version = 7
+onnx.save(model_def, 'external_data.onnx', save_as_external_data=True, all_tensors_to_one_file=True,
+          location='external_data.bin', size_threshold=0)
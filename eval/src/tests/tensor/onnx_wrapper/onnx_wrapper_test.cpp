@@ -1,6 +1,8 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
+#include <vespa/eval/eval/fast_value.h>
 #include <vespa/eval/eval/tensor_spec.h>
+#include <vespa/eval/eval/value_codec.h>
 #include <vespa/eval/eval/int8float.h>
 #include <vespa/eval/eval/test/eval_onnx.h>
 #include <vespa/eval/onnx/onnx_wrapper.h>
@@ -8,6 +10,7 @@
 #include <vespa/vespalib/util/bfloat16.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <filesystem>
 
 using namespace vespalib::eval;
 
@@ -30,6 +33,8 @@ std::string guess_batch_model = source_dir + "/guess_batch.onnx";
 std::string unstable_types_model = source_dir + "/unstable_types.onnx";
 std::string float_to_int8_model = source_dir + "/float_to_int8.onnx";
 std::string probe_model = source_dir + "/probe_model.onnx";
+std::string batched_model = source_dir + "/batched.onnx";
+std::string external_data_model = source_dir + "/external_data.onnx";
 
 void dump_info(const char *ctx, const std::vector<TensorInfo> &info) {
     fprintf(stderr, "%s:\n", ctx);
@@ -510,6 +515,59 @@ TEST(OnnxModelCacheTest, share_and_evict_onnx_models) {
     EXPECT_EQ(OnnxModelCache::count_refs(), 0);
 }
 
+TEST(OnnxModelCacheTest, models_with_same_content_are_shared) {
+    std::string simple_copy = "simple_copy.onnx";
+    std::filesystem::copy_file(simple_model, simple_copy, std::filesystem::copy_options::overwrite_existing);
+    {
+        auto simple1 = OnnxModelCache::load(simple_model);
+        auto simple2 = OnnxModelCache::load(simple_copy);
+        auto dynamic = OnnxModelCache::load(dynamic_model);
+        EXPECT_EQ(&(simple1->get()), &(simple2->get()));
+        EXPECT_EQ(OnnxModelCache::num_cached(), 2);
+        EXPECT_EQ(OnnxModelCache::count_refs(), 3);
+        auto models = OnnxModelCache::list_models();
+        ASSERT_EQ(models.size(), 2);
+        size_t simple_idx = (models[0].file == simple_model) ? 0 : 1;
+        EXPECT_EQ(models[simple_idx].file, simple_model);
+        EXPECT_EQ(models[simple_idx].file_size, std::filesystem::file_size(simple_model));
+        EXPECT_EQ(models[simple_idx].num_refs, 2);
+        EXPECT_FALSE(models[simple_idx].mapped_weights);
+        EXPECT_EQ(models[1 - simple_idx].file, dynamic_model);
+        EXPECT_EQ(models[1 - simple_idx].num_refs, 1);
+    }
+    EXPECT_EQ(OnnxModelCache::num_cached(), 0);
+    EXPECT_TRUE(OnnxModelCache::list_models().empty());
+    std::filesystem::remove(simple_copy);
+}
+
+TEST(OnnxModelCacheTest, models_with_external_data_are_only_shared_by_path) {
+    std::filesystem::create_directory("external_copy");
+    std::string external_copy = "external_copy/external_data.onnx";
+    std::filesystem::copy_file(external_data_model, external_copy, std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::copy_file(source_dir + "/external_data.bin", "external_copy/external_data.bin",
+                               std::filesystem::copy_options::overwrite_existing);
+    {
+        auto model1 = OnnxModelCache::load(external_data_model);
+        auto model2 = OnnxModelCache::load(external_data_model);
+        auto model3 = OnnxModelCache::load(external_copy);
+        EXPECT_EQ(&(model1->get()), &(model2->get()));
+        EXPECT_NE(&(model1->get()), &(model3->get()));
+        EXPECT_EQ(OnnxModelCache::num_cached(), 2);
+        EXPECT_EQ(OnnxModelCache::count_refs(), 3);
+    }
+    EXPECT_EQ(OnnxModelCache::num_cached(), 0);
+    std::filesystem::remove_all("external_copy");
+}
+
+TEST(OnnxTest, ort_format_models_are_detected) {
+    const char ort_header[] = "\x18\0\0\0ORTM"; // start of an ORT format model file
+    EXPECT_TRUE(Onnx::is_ort_format(ort_header, 8));
+    EXPECT_FALSE(Onnx::is_ort_format(ort_header, 7));
+    EXPECT_FALSE(Onnx::is_ort_format("\x08\x07\x12\x08test", 8));
+    Onnx model(simple_model, Onnx::Optimize::ENABLE);
+    EXPECT_FALSE(model.weights_are_mapped());
+}
+
 TensorSpec val(const std::string &expr) {
     auto result = TensorSpec::from_expr(expr);
     EXPECT_FALSE(ValueType::from_spec(result.type()).is_error());
@@ -530,4 +588,60 @@ TEST(OnnxTest, eval_onnx_with_probe_model) {
     EXPECT_EQ(result[2], out3);
 }
 
+TEST(OnnxTest, batch_dimension_must_be_shared_and_bound_to_size_one) {
+    Onnx model(batched_model, Onnx::Optimize::ENABLE);
+    Onnx::WirePlanner planner_1;
+    EXPECT_TRUE(planner_1.bind_input_type(ValueType::from_spec("tensor<float>(a[1],b[3])"), model.inputs()[0]));
+    EXPECT_TRUE(planner_1.bind_input_type(ValueType::from_spec("tensor(a[1],b[3])"), model.inputs()[1]));
+    EXPECT_TRUE(planner_1.can_batch(model));
+    Onnx::WirePlanner planner_2;
+    EXPECT_TRUE(planner_2.bind_input_type(ValueType::from_spec("tensor<float>(a[2],b[3])"), model.inputs()[0]));
+    EXPECT_TRUE(planner_2.bind_input_type(ValueType::from_spec("tensor(a[2],b[3])"), model.inputs()[1]));
+    EXPECT_FALSE(planner_2.can_batch(model));
+    Onnx other_model(dynamic_model, Onnx::Optimize::ENABLE);
+    Onnx::WirePlanner planner_3;
+    EXPECT_TRUE(planner_3.bind_input_type(ValueType::from_spec("tensor<float>(a[1],b[4])"), other_model.inputs()[0]));
+    EXPECT_TRUE(planner_3.bind_input_type(ValueType::from_spec("tensor<float>(a[4],b[1])"), other_model.inputs()[1]));
+    EXPECT_TRUE(planner_3.bind_input_type(ValueType::from_spec("tensor<float>(a[1],b[2])"), other_model.inputs()[2]));
+    EXPECT_FALSE(planner_3.can_batch(other_model));
+}
+
+TEST(OnnxTest, batch_of_evaluations_gives_same_results_as_separate_evaluations) {
+    Onnx model(batched_model, Onnx::Optimize::ENABLE);
+    Onnx::WirePlanner planner;
+    EXPECT_TRUE(planner.bind_input_type(ValueType::from_spec("tensor<float>(a[1],b[3])"), model.inputs()[0]));
+    EXPECT_TRUE(planner.bind_input_type(ValueType::from_spec("tensor(a[1],b[3])"), model.inputs()[1]));
+    planner.prepare_output_types(model);
+    ASSERT_TRUE(planner.can_batch(model));
+    Onnx::WireInfo wire_info = planner.get_wire_info(model);
+    Onnx::EvalContext ctx(model, wire_info);
+    Onnx::BatchEvalContext batch_ctx(model, wire_info, 4);
+    EXPECT_EQ(batch_ctx.max_batch_size(), 4);
+    std::vector<std::pair<TensorSpec,TensorSpec>> inputs;
+    for (size_t i = 0; i < 3; ++i) {
+        inputs.emplace_back(val(fmt("tensor<float>(a[1],b[3]):[[%zu,2,3]]", i)),
+                            val(fmt("tensor(a[1],b[3]):[[1,%zu,1]]", i + 1)));
+    }
+    std::vector<Value::UP> values;
+    for (size_t slot = 0; slot < inputs.size(); ++slot) {
+        values.push_back(value_from_spec(inputs[slot].first, FastValueBuilderFactory::get()));
+        batch_ctx.bind_param(0, slot, *values.back());
+        values.push_back(value_from_spec(inputs[slot].second, FastValueBuilderFactory::get()));
+        batch_ctx.bind_param(1, slot, *values.back());
+    }
+    batch_ctx.eval(inputs.size());
+    for (size_t slot = 0; slot < inputs.size(); ++slot) {
+        auto in1 = value_from_spec(inputs[slot].first, FastValueBuilderFactory::get());
+        auto in2 = value_from_spec(inputs[slot].second, FastValueBuilderFactory::get());
+        ctx.bind_param(0, *in1);
+        ctx.bind_param(1, *in2);
+        ctx.eval();
+        for (size_t i = 0; i < batch_ctx.num_results(); ++i) {
+            auto result = batch_ctx.extract_result(i, slot);
+            EXPECT_EQ(TensorSpec::from_value(*result), TensorSpec::from_value(ctx.get_result(i)));
+        }
+    }
+    EXPECT_EQ(TensorSpec::from_value(*batch_ctx.extract_result(1, 2)), val("tensor<float>(d0[1],d1[1]):[[11]]"));
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
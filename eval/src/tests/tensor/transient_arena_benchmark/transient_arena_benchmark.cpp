@@ -0,0 +1,84 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+// Benchmark evaluating expressions with sparse and mixed intermediate
+// results, reporting how many cell allocations each evaluation needs
+// and how many of them still end up as heap allocations when the
+// cells are taken from the arena of the evaluation context.
+
+#include <vespa/eval/eval/fast_value.h>
+#include <vespa/eval/eval/function.h>
+#include <vespa/eval/eval/interpreted_function.h>
+#include <vespa/eval/eval/node_types.h>
+#include <vespa/eval/eval/value_codec.h>
+#include <vespa/eval/eval/test/gen_spec.h>
+#include <vespa/vespalib/util/arena_memory_allocator.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::eval::test;
+
+double budget = 1.0;
+
+void benchmark(const std::string &expr, std::vector<GenSpec> param_specs) {
+    auto fun = Function::parse(expr);
+    ASSERT_EQ(fun->num_params(), param_specs.size());
+    std::vector<Value::UP> values;
+    std::vector<Value::CREF> refs;
+    std::vector<ValueType> types;
+    for (const auto &spec: param_specs) {
+        values.push_back(value_from_spec(spec, FastValueBuilderFactory::get()));
+        refs.push_back(*values.back());
+        types.push_back(values.back()->type());
+    }
+    NodeTypes node_types(*fun, types);
+    ASSERT_FALSE(node_types.get_type(fun->root()).is_error());
+    InterpretedFunction ifun(FastValueBuilderFactory::get(), *fun, node_types);
+    InterpretedFunction::Context ctx(ifun);
+    SimpleObjectParams params(refs);
+    // warm-up; the second evaluation merges the arena blocks used by the first one
+    ifun.eval(ctx, params);
+    ifun.eval(ctx, params);
+    auto before = ctx.arena().get_stats();
+    size_t evals = 0;
+    auto run = [&]() {
+                   ifun.eval(ctx, params);
+                   ++evals;
+               };
+    double min_time_us = BenchmarkTimer::benchmark(run, budget) * 1000.0 * 1000.0;
+    auto after = ctx.arena().get_stats();
+    double cell_allocs = double(after.allocations - before.allocations) / evals;
+    double heap_allocs = double(after.block_allocations - before.block_allocations) / evals;
+    fprintf(stderr, "%s\n", expr.c_str());
+    fprintf(stderr, "    time per eval:                %10.3f us\n", min_time_us);
+    fprintf(stderr, "    cell allocations per eval:    %10.3f (heap without arena)\n", cell_allocs);
+    fprintf(stderr, "    arena heap allocations/eval:  %10.3f (over %zu evals)\n", heap_allocs, evals);
+    EXPECT_GT(cell_allocs, 0.0);
+    EXPECT_EQ(heap_allocs, 0.0);
+}
+
+TEST(TransientArenaBench, sparse_expressions) {
+    auto a = GenSpec(1.0).map("x", 32, 1).map("y", 16, 2);
+    auto b = GenSpec(2.0).map("y", 16, 1).map("z", 32, 3);
+    benchmark("reduce(a*b,sum,y)", {a, b});
+    benchmark("reduce(a*b+a,max,x)", {a, b});
+}
+
+TEST(TransientArenaBench, mixed_expressions) {
+    auto a = GenSpec(1.0).map("x", 32, 1).idx("y", 16);
+    auto b = GenSpec(2.0).idx("y", 16).map("z", 32, 2);
+    benchmark("reduce(a*b,sum,y)", {a, b});
+    benchmark("reduce(tanh(a*b)+a,sum,x,z)", {a, b});
+}
+
+int main(int argc, char **argv) {
+    const std::string smoke_test_option = "--smoke-test";
+    if ((argc > 1) && (argv[1] == smoke_test_option)) {
+        budget = 0.001;
+        ++argv;
+        --argc;
+    }
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
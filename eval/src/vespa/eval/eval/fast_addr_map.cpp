@@ -7,7 +7,8 @@ namespace vespalib::eval {
 
 FastAddrMap::FastAddrMap(size_t num_mapped_dims, const StringIdVector &labels_in, size_t expected_subspaces)
     : _labels(num_mapped_dims, labels_in),
-      _map(expected_subspaces * 2, Hash(), Equal(_labels))
+      _map(expected_subspaces * 2, Hash(), Equal(_labels)),
+      _sorted(true)
 {}
 FastAddrMap::~FastAddrMap() = default;
 
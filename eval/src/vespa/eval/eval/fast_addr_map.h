@@ -14,7 +14,10 @@ namespace vespalib::eval {
  * A wrapper around vespalib::hashtable, using it to map a list of
  * labels (a sparse address) to an integer value (dense subspace
  * index). Labels are represented by string enum values stored and
- * handled outside this class.
+ * handled outside this class. The map also keeps track of whether
+ * addresses were added in strictly increasing order (comparing
+ * string enum values label by label). Two sorted maps can be joined
+ * by merging their labels instead of performing hash lookups.
  **/
 class FastAddrMap
 {
@@ -102,6 +105,16 @@ public:
 private:
     LabelView _labels;
     HashType _map;
+    bool _sorted;
+
+    static bool addr_less(std::span<const string_id> a, std::span<const string_id> b) noexcept {
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i] != b[i]) {
+                return (a[i] < b[i]);
+            }
+        }
+        return false;
+    }
 
 public:
     FastAddrMap(size_t num_mapped_dims, const StringIdVector &labels_in, size_t expected_subspaces);
@@ -115,6 +128,7 @@ public:
     size_t size() const noexcept { return _map.size(); }
     constexpr size_t addr_size() const noexcept { return _labels.addr_size; }
     const StringIdVector &labels() const noexcept { return _labels.labels; }
+    bool is_sorted() const noexcept { return _sorted; }
     template <typename T>
     size_t lookup(std::span<const T> addr, uint32_t hash) const noexcept {
         // assert(addr_size() == addr.size());
@@ -135,6 +149,9 @@ public:
     }
     void add_mapping(uint32_t hash) {
         uint32_t idx = _map.size();
+        if (_sorted && (idx > 0)) {
+            _sorted = addr_less(get_addr(idx - 1), get_addr(idx));
+        }
         _map.force_insert(Entry{{idx}, hash});
     }
     template <typename F>
@@ -144,6 +161,49 @@ public:
                           f(entry.tag.idx, entry.hash);
                       });
     }
+    // prefer merging sorted maps unless one of them is much smaller
+    // than the other; hash lookups are then cheaper than a full scan
+    static bool should_merge(const FastAddrMap &a, const FastAddrMap &b) noexcept {
+        return (a.is_sorted() && b.is_sorted() &&
+                (a.size() <= (b.size() * 8)) && (b.size() <= (a.size() * 8)));
+    }
+    // call f(a_subspace, b_subspace) for all addresses found in both
+    // maps, in address order; both maps must be sorted.
+    template <typename F>
+    static void merge(const FastAddrMap &a, const FastAddrMap &b, F &&f) {
+        // assert(a.is_sorted() && b.is_sorted() && (a.addr_size() == b.addr_size()));
+        size_t a_idx = 0;
+        size_t b_idx = 0;
+        const size_t a_size = a.size();
+        const size_t b_size = b.size();
+        if (a.addr_size() == 1) {
+            const string_id *a_labels = a.labels().data();
+            const string_id *b_labels = b.labels().data();
+            while ((a_idx < a_size) && (b_idx < b_size)) {
+                uint32_t a_label = a_labels[a_idx].value();
+                uint32_t b_label = b_labels[b_idx].value();
+                if (a_label == b_label) {
+                    f(a_idx++, b_idx++);
+                } else {
+                    // branch-free step of the side with the smallest label
+                    a_idx += (a_label < b_label);
+                    b_idx += (b_label < a_label);
+                }
+            }
+        } else {
+            while ((a_idx < a_size) && (b_idx < b_size)) {
+                auto a_addr = a.get_addr(a_idx);
+                auto b_addr = b.get_addr(b_idx);
+                if (addr_less(a_addr, b_addr)) {
+                    ++a_idx;
+                } else if (addr_less(b_addr, a_addr)) {
+                    ++b_idx;
+                } else {
+                    f(a_idx++, b_idx++);
+                }
+            }
+        }
+    }
     MemoryUsage estimate_extra_memory_usage() const {
         MemoryUsage extra_usage;
         size_t map_self_size = sizeof(_map);
@@ -8,6 +8,7 @@
 #include <vespa/vespalib/util/benchmark_timer.h>
 #include <algorithm>
 #include <cassert>
+#include <limits>
 #include <arpa/inet.h>
 
 namespace vespalib::eval::gbdt {
@@ -143,10 +144,14 @@ template <> std::string fixed_impl_name<uint64_t>() { return "ff-fixed<64>"; }
 template <typename T>
 constexpr size_t max_leafs() { return (sizeof(T) * bits_per_byte); }
 
+// number of documents evaluated side by side in batch mode
+constexpr size_t batch_lanes = 8;
+
 template <typename T>
 struct FixedContext : FastForest::Context {
     std::vector<T> masks;
-    FixedContext(size_t num_trees) : masks(num_trees) {}
+    std::vector<T> lane_masks; // [tree][lane], allocated on first batch
+    FixedContext(size_t num_trees) : masks(num_trees), lane_masks() {}
 };
 
 template <typename T>
@@ -197,9 +202,16 @@ struct FixedForest : FastForest {
     static void apply_masks(T *ctx_masks, const DMask *pos, const DMask *end);
     double get_result(const T *ctx_masks) const;
 
+    static void apply_lane_masks(T *lane_masks, const Mask *pos, const Mask *end, const float *features, float limit);
+    static void apply_lane_masks(T *lane_masks, const DMask *pos, const DMask *end, size_t lane);
+    void get_lane_results(const T *lane_masks, size_t num_lanes, double *results) const;
+    void eval_lanes(FixedContext<T> &ctx, const float *params, size_t num_lanes, double *results) const;
+
     std::string impl_name() const override { return fixed_impl_name<T>(); }
     Context::UP create_context() const override;
+    size_t num_params() const override { return _mask_sizes.size(); }
     double eval(Context &context, const float *params) const override;
+    void eval_batch(Context &context, const float *params, size_t num_docs, double *results) const override;
 };
 
 template <typename T>
@@ -335,6 +347,106 @@ FixedForest<T>::eval(Context &context, const float *params) const
     return get_result(ctx_masks);
 }
 
+template <typename T>
+void
+FixedForest<T>::apply_lane_masks(T *lane_masks, const Mask *pos, const Mask *end, const float *features, float limit)
+{
+    // masks are sorted on value; continue until no lane will accept
+    // more of them and select per lane using vector compares. Lanes
+    // with missing (NaN) values never match since all comparisons fail.
+    typedef float FloatLanes __attribute__ ((vector_size (batch_lanes * sizeof(float))));
+    typedef int32_t HitLanes __attribute__ ((vector_size (batch_lanes * sizeof(int32_t))));
+    typedef T MaskLanes __attribute__ ((vector_size (batch_lanes * sizeof(T))));
+    FloatLanes lane_features;
+    memcpy(&lane_features, features, sizeof(lane_features));
+    for (; (pos < end) && !(limit < pos->value); ++pos) {
+        HitLanes hit = (lane_features >= pos->value);
+        MaskLanes keep = ~__builtin_convertvector(hit, MaskLanes);
+        MaskLanes masks;
+        T *dst = lane_masks + (pos->tree * batch_lanes);
+        memcpy(&masks, dst, sizeof(masks));
+        masks &= (keep | pos->bits);
+        memcpy(dst, &masks, sizeof(masks));
+    }
+}
+
+template <typename T>
+void
+FixedForest<T>::apply_lane_masks(T *lane_masks, const DMask *pos, const DMask *end, size_t lane)
+{
+    for (; pos < end; ++pos) {
+        lane_masks[(pos->tree * batch_lanes) + lane] &= pos->bits;
+    }
+}
+
+template <typename T>
+void
+FixedForest<T>::get_lane_results(const T *lane_masks, size_t num_lanes, double *results) const
+{
+    // trees are summed in the same order as for single evaluation
+    // (see get_result) to produce identical results
+    double result1[batch_lanes] = {};
+    double result2[batch_lanes] = {};
+    const float *leafs = &_padded_leafs[0];
+    size_t leaf_cnt = _max_leafs;
+    size_t split_trees = (_num_trees & ~size_t(3));
+    for (size_t tree = 0; tree < _num_trees; ++tree, lane_masks += batch_lanes, leafs += leaf_cnt) {
+        double *dst = ((tree < split_trees) && ((tree & 1) == 1)) ? result2 : result1;
+        for (size_t lane = 0; lane < batch_lanes; ++lane) {
+            dst[lane] += leafs[get_lsb(lane_masks[lane])];
+        }
+    }
+    for (size_t lane = 0; lane < num_lanes; ++lane) {
+        results[lane] = (result1[lane] + result2[lane]);
+    }
+}
+
+template <typename T>
+void
+FixedForest<T>::eval_lanes(FixedContext<T> &ctx, const float *params, size_t num_lanes, double *results) const
+{
+    size_t num_features = _mask_sizes.size();
+    T *lane_masks = &ctx.lane_masks[0];
+    memset(lane_masks, 0xff, _num_trees * batch_lanes * sizeof(T));
+    const Mask *mask_pos = &_masks[0];
+    for (size_t feature = 0; feature < num_features; ++feature) {
+        float features[batch_lanes];
+        float limit = -std::numeric_limits<float>::infinity();
+        for (size_t lane = 0; lane < batch_lanes; ++lane) {
+            float value = (lane < num_lanes)
+                          ? params[(lane * num_features) + feature]
+                          : std::numeric_limits<float>::quiet_NaN();
+            if (!std::isnan(value)) {
+                limit = std::max(limit, value);
+            } else if (lane < num_lanes) {
+                apply_lane_masks(lane_masks,
+                                 &_default_masks[_default_offsets[feature]],
+                                 &_default_masks[_default_offsets[feature + 1]], lane);
+            }
+            features[lane] = value;
+        }
+        uint32_t size = _mask_sizes[feature];
+        apply_lane_masks(lane_masks, mask_pos, mask_pos + size, features, limit);
+        mask_pos += size;
+    }
+    get_lane_results(lane_masks, num_lanes, results);
+}
+
+template <typename T>
+void
+FixedForest<T>::eval_batch(Context &context, const float *params, size_t num_docs, double *results) const
+{
+    auto &ctx = static_cast<FixedContext<T>&>(context);
+    if (ctx.lane_masks.empty()) {
+        ctx.lane_masks.resize(_num_trees * batch_lanes);
+    }
+    size_t num_features = _mask_sizes.size();
+    for (size_t offset = 0; offset < num_docs; offset += batch_lanes) {
+        size_t num_lanes = std::min(batch_lanes, num_docs - offset);
+        eval_lanes(ctx, params + (offset * num_features), num_lanes, results + offset);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // implementation using multiple words for each tree
 //-----------------------------------------------------------------------------
@@ -439,6 +551,7 @@ struct MultiWordForest : FastForest {
 
     std::string impl_name() const override { return "ff-multiword"; }
     Context::UP create_context() const override;
+    size_t num_params() const override { return _mask_sizes.size(); }
     double eval(Context &context, const float *params) const override;
 };
 
@@ -661,6 +774,15 @@ FastForest::try_convert(const Function &fun, size_t min_fixed, size_t max_fixed)
     return FastForest::UP();
 }
 
+void
+FastForest::eval_batch(Context &context, const float *params, size_t num_docs, double *results) const
+{
+    size_t stride = num_params();
+    for (size_t i = 0; i < num_docs; ++i) {
+        results[i] = eval(context, params + (i * stride));
+    }
+}
+
 double
 FastForest::estimate_cost_us(const std::vector<double> &params, double budget) const
 {
@@ -669,4 +791,17 @@ FastForest::estimate_cost_us(const std::vector<double> &params, double budget) c
     return BenchmarkTimer::benchmark([&](){ eval(*ctx, &my_params[0]); }, budget) * 1000.0 * 1000.0;
 }
 
+double
+FastForest::estimate_batch_cost_us(const std::vector<double> &params, size_t num_docs, double budget) const
+{
+    auto ctx = create_context();
+    std::vector<float> my_params;
+    for (size_t i = 0; i < num_docs; ++i) {
+        my_params.insert(my_params.end(), params.begin(), params.end());
+    }
+    std::vector<double> results(num_docs);
+    double us = BenchmarkTimer::benchmark([&](){ eval_batch(*ctx, &my_params[0], num_docs, &results[0]); }, budget) * 1000.0 * 1000.0;
+    return (us / num_docs);
+}
+
 }
@@ -17,6 +17,11 @@ namespace vespalib::eval::gbdt {
  * Comparisons must be on the form 'feature < const' or '!(feature >=
  * const)'. The inverted form is used to signal that the true branch
  * should be selected when the feature value is missing (NaN).
+ *
+ * Several documents may be evaluated together with eval_batch. The
+ * parameters of each document are stored after each other, and the
+ * result of each document is written to the results array. A context
+ * must not be used by more than one thread at a time.
  **/
 class FastForest
 {
@@ -35,8 +40,12 @@ public:
     static UP try_convert(const Function &fun, size_t min_fixed = 8, size_t max_fixed = 64);
     virtual std::string impl_name() const = 0;
     virtual Context::UP create_context() const = 0;
+    virtual size_t num_params() const = 0;
     virtual double eval(Context &context, const float *params) const = 0;
+    virtual void eval_batch(Context &context, const float *params, size_t num_docs, double *results) const;
     double estimate_cost_us(const std::vector<double> &params, double budget = 5.0) const;
+    // cost per document when evaluating 'num_docs' documents together
+    double estimate_batch_cost_us(const std::vector<double> &params, size_t num_docs, double budget = 5.0) const;
 };
 
 }
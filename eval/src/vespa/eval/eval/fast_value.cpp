@@ -18,7 +18,8 @@ struct CreateFastValueBuilderBase {
         if (type.is_double()) {
             return std::make_unique<FastDoubleValueBuilder>();
         } else if (num_mapped_dims == 0) {
-            return std::make_unique<FastDenseValue<T>>(type, subspace_size);
+            return std::make_unique<FastDenseValue<T>>(type, subspace_size,
+                                                       R2::value ? FastValueBuilderFactory::transient_arena() : nullptr);
         } else {
             return std::make_unique<FastValue<T,R2::value>>(type, num_mapped_dims, subspace_size, expected_subspaces);
         }
@@ -164,9 +165,32 @@ FastValueIndex::create_view(std::span<const size_t> dims) const
 
 //-----------------------------------------------------------------------------
 
+namespace {
+
+thread_local const alloc::MemoryAllocator *bound_transient_arena = nullptr;
+
+} // namespace <unnamed>
+
 FastValueBuilderFactory::FastValueBuilderFactory() = default;
 FastValueBuilderFactory FastValueBuilderFactory::_factory;
 
+const alloc::MemoryAllocator *
+FastValueBuilderFactory::transient_arena() noexcept
+{
+    return bound_transient_arena;
+}
+
+FastValueBuilderFactory::ArenaBinding::ArenaBinding(const alloc::MemoryAllocator &arena) noexcept
+    : _prev(bound_transient_arena)
+{
+    bound_transient_arena = &arena;
+}
+
+FastValueBuilderFactory::ArenaBinding::~ArenaBinding()
+{
+    bound_transient_arena = _prev;
+}
+
 std::unique_ptr<ValueBuilderBase>
 FastValueBuilderFactory::create_value_builder_base(const ValueType &type, bool transient, size_t num_mapped_dims, size_t subspace_size,
                                                    size_t expected_subspaces) const
@@ -4,6 +4,8 @@
 
 #include "value_builder_factory.h"
 
+namespace vespalib::alloc { class MemoryAllocator; }
+
 namespace vespalib::eval {
 
 /**
@@ -14,6 +16,12 @@ namespace vespalib::eval {
  * FastSparseMap used by the FastValueIndex is a highly optimized
  * alternative to the map used by SimpleValue, which means that normal
  * Value API usage will also have improved performance.
+ *
+ * The cells of transient fast values are taken from the arena bound
+ * to the current thread (see ArenaBinding), if any. The interpreter
+ * binds the arena of its context while evaluating, since transient
+ * values are only used for intermediate results that do not outlive
+ * the evaluation context.
  **/
 class FastValueBuilderFactory : public ValueBuilderFactory {
 private:
@@ -23,6 +31,17 @@ private:
             size_t num_mapped_dims, size_t subspace_size, size_t expected_subspaces) const override;
 public:
     static const FastValueBuilderFactory &get() { return _factory; }
+    // arena for transient cells in the current thread; nullptr means heap
+    static const alloc::MemoryAllocator *transient_arena() noexcept;
+    class ArenaBinding {
+    private:
+        const alloc::MemoryAllocator *_prev;
+    public:
+        explicit ArenaBinding(const alloc::MemoryAllocator &arena) noexcept;
+        ArenaBinding(const ArenaBinding &) = delete;
+        ArenaBinding &operator=(const ArenaBinding &) = delete;
+        ~ArenaBinding();
+    };
 };
 
 }
@@ -1,6 +1,6 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
-#include "value_builder_factory.h"
+#include "fast_value.h"
 #include "fast_value_index.h"
 #include "inline_operation.h"
 #include <vespa/eval/instruction/generic_join.h>
@@ -36,7 +36,7 @@ struct FastCells {
     size_t capacity;
     size_t size;
     mutable alloc::Alloc memory;
-    explicit FastCells(size_t initial_capacity);
+    explicit FastCells(size_t initial_capacity, const alloc::MemoryAllocator *allocator = nullptr);
     FastCells(const FastCells &) = delete;
     FastCells & operator = (const FastCells &) = delete;
     ~FastCells();
@@ -67,10 +67,11 @@ struct FastCells {
 };
 
 template <typename T>
-FastCells<T>::FastCells(size_t initial_capacity)
+FastCells<T>::FastCells(size_t initial_capacity, const alloc::MemoryAllocator *allocator)
     : capacity(roundUp2inN(initial_capacity)),
       size(0),
-      memory(alloc::Alloc::alloc(elem_size * capacity))
+      memory(allocator ? alloc::Alloc::alloc_with_allocator(allocator).create(elem_size * capacity)
+                       : alloc::Alloc::alloc(elem_size * capacity))
 {
     static_assert(std::is_trivially_copyable_v<T>);
     static_assert(can_skip_destruction<T>);
@@ -80,7 +81,7 @@ template <typename T>
 void
 FastCells<T>::reallocate(size_t need) {
     capacity = roundUp2inN(size + need);
-    alloc::Alloc new_memory = alloc::Alloc::alloc(elem_size * capacity);
+    alloc::Alloc new_memory = memory.create(elem_size * capacity);
     if (memory.get()) {
         memcpy(new_memory.get(), memory.get(), elem_size * size);
     }
@@ -198,7 +199,8 @@ FastValue<T,transient>::FastValue(const ValueType &type_in, size_t num_mapped_di
     : my_type(type_in), my_subspace_size(subspace_size_in),
       my_handles(),
       my_index(num_mapped_dims_in, get_view(my_handles), expected_subspaces_in),
-      my_cells(subspace_size_in * expected_subspaces_in)
+      my_cells(subspace_size_in * expected_subspaces_in,
+               transient ? FastValueBuilderFactory::transient_arena() : nullptr)
 {
     my_handles.reserve(expected_subspaces_in * num_mapped_dims_in);
 }
@@ -214,8 +216,8 @@ struct FastDenseValue final : Value, ValueBuilder<T> {
     ValueType my_type;
     FastCells<T> my_cells;
 
-    FastDenseValue(const ValueType &type_in, size_t subspace_size_in)
-        : my_type(type_in), my_cells(subspace_size_in)
+    FastDenseValue(const ValueType &type_in, size_t subspace_size_in, const alloc::MemoryAllocator *allocator = nullptr)
+        : my_type(type_in), my_cells(subspace_size_in, allocator)
     {
         my_cells.add_cells(subspace_size_in);
     }
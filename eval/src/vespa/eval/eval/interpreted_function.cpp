@@ -7,9 +7,11 @@
 #include "make_tensor_function.h"
 #include "optimize_tensor_function.h"
 #include "compile_tensor_function.h"
+#include "fast_value.h"
 #include <vespa/vespalib/util/classname.h>
 #include <vespa/eval/eval/llvm/compile_cache.h>
 #include <vespa/eval/eval/llvm/addr_to_symbol.h>
+#include <vespa/vespalib/util/arena_memory_allocator.h>
 #include <vespa/vespalib/util/benchmark_timer.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <set>
@@ -46,9 +48,10 @@ void my_nop(InterpretedFunction::State &, uint64_t) {}
 } // namespace vespalib::<unnamed>
 
 
-InterpretedFunction::State::State(const ValueBuilderFactory &factory_in)
+InterpretedFunction::State::State(const ValueBuilderFactory &factory_in, size_t arena_retain_limit)
     : factory(factory_in),
       params(nullptr),
+      arena(std::make_unique<alloc::ArenaMemoryAllocator>(arena_retain_limit)),
       stash(),
       stack(),
       program_offset(0),
@@ -62,16 +65,30 @@ void
 InterpretedFunction::State::init(const LazyParams &params_in) {
     params = &params_in;
     stash.clear();
+    arena->reset(); // after the values using it are gone
     stack.clear();
     program_offset = 0;
     if_cnt = 0;
 }
 
 InterpretedFunction::Context::Context(const InterpretedFunction &ifun)
-  : _state(ifun._factory)
+  : Context(ifun, alloc::ArenaMemoryAllocator::DEFAULT_RETAIN_LIMIT)
 {
 }
 
+InterpretedFunction::Context::Context(const InterpretedFunction &ifun, size_t arena_retain_limit)
+  : _state(ifun._factory, arena_retain_limit)
+{
+}
+
+MemoryUsage
+InterpretedFunction::Context::get_memory_usage() const
+{
+    MemoryUsage usage = _state.stash.get_memory_usage();
+    usage.merge(_state.arena->get_memory_usage());
+    return usage;
+}
+
 InterpretedFunction::ProfiledContext::ProfiledContext(const InterpretedFunction &ifun)
   : context(ifun),
     cost(ifun.program_size(), std::make_pair(size_t(0), duration::zero()))
@@ -120,6 +137,7 @@ InterpretedFunction::eval(Context &ctx, const LazyParams &params) const
 {
     State &state = ctx._state;
     state.init(params);
+    FastValueBuilderFactory::ArenaBinding arena_binding(*state.arena);
     while (state.program_offset < _program.size()) {
         _program[state.program_offset++].perform(state);
     }
@@ -133,6 +151,7 @@ InterpretedFunction::eval(ProfiledContext &pctx, const LazyParams &params) const
     auto &ctx = pctx.context;                            // Profiling
     State &state = ctx._state;
     state.init(params);
+    FastValueBuilderFactory::ArenaBinding arena_binding(*state.arena);
     while (state.program_offset < _program.size()) {
         auto pos = state.program_offset;                 // Profiling
         auto before = steady_clock::now();               // Profiling
@@ -184,7 +203,7 @@ InterpretedFunction::detect_issues(const Function &function)
 }
 
 InterpretedFunction::EvalSingle::EvalSingle(const ValueBuilderFactory &factory, Instruction op, const LazyParams &params)
-    : _state(factory),
+    : _state(factory, alloc::ArenaMemoryAllocator::DEFAULT_RETAIN_LIMIT),
       _op(op)
 {
     _state.params = &params;
@@ -194,7 +213,9 @@ const Value &
 InterpretedFunction::EvalSingle::eval(const std::vector<Value::CREF> &stack)
 {
     _state.stash.clear();
+    _state.arena->reset();
     _state.stack = stack;
+    FastValueBuilderFactory::ArenaBinding arena_binding(*_state.arena);
     _op.perform(_state);
     assert(_state.stack.size() == 1);
     return _state.stack.back();
@@ -9,6 +9,8 @@
 #include <vespa/vespalib/util/stash.h>
 #include <vespa/vespalib/util/time.h>
 
+namespace vespalib::alloc { class ArenaMemoryAllocator; }
+
 namespace vespalib::eval {
 
 namespace nodes { struct Node; }
@@ -25,7 +27,13 @@ struct ValueBuilderFactory;
  * run-time state related to the evaluation of an interpreted
  * function. The result of an evaluation is only valid until either
  * the context is destructed or the context is re-used to perform
- * another evaluation.
+ * another evaluation. Intermediate values are allocated from the
+ * stash and the arena of the context, both of which are reset
+ * (keeping their memory) before each evaluation. The arena keeps at
+ * most its retain limit (alloc::ArenaMemoryAllocator::DEFAULT_RETAIN_LIMIT,
+ * 256 KiB, unless given when creating the context) between
+ * evaluations; memory needed beyond that is released on the next
+ * reset.
  **/
 class InterpretedFunction
 {
@@ -33,12 +41,13 @@ public:
     struct State {
         const ValueBuilderFactory &factory;
         const LazyParams          *params;
+        std::unique_ptr<alloc::ArenaMemoryAllocator> arena; // cells of transient values
         Stash                      stash;
         std::vector<Value::CREF>   stack;
         uint32_t                   program_offset;
         uint32_t                   if_cnt;
 
-        State(const ValueBuilderFactory &factory_in);
+        State(const ValueBuilderFactory &factory_in, size_t arena_retain_limit);
         ~State();
 
         void init(const LazyParams &params_in);
@@ -68,7 +77,11 @@ public:
         State _state;
     public:
         explicit Context(const InterpretedFunction &ifun);
+        Context(const InterpretedFunction &ifun, size_t arena_retain_limit);
         uint32_t if_cnt() const { return _state.if_cnt; }
+        const alloc::ArenaMemoryAllocator &arena() const { return *_state.arena; }
+        // memory held by the stash and the arena
+        MemoryUsage get_memory_usage() const;
     };
     struct ProfiledContext {
         Context context;
@@ -61,34 +61,51 @@ double Cube::f(double a) { return (a * a * a); }
 
 namespace {
 
+// known ops by function key, and the first expression listed for each op
 template <typename T>
-void add_op(std::map<std::string,T> &map, const Function &fun, T op) {
+struct OpMap {
+    std::map<std::string,T> ops;
+    std::map<T,std::string> exprs;
+};
+
+template <typename T>
+void add_op(OpMap<T> &map, const Function &fun, const std::string &expr, T op) {
     assert(!fun.has_error());
     auto key = gen_key(fun, PassParams::SEPARATE);
-    auto res = map.emplace(key, op);
+    auto res = map.ops.emplace(key, op);
     assert(res.second);
+    map.exprs.emplace(op, expr);
 }
 
 template <typename T>
-std::optional<T> lookup_op(const std::map<std::string,T> &map, const Function &fun) {
+std::optional<T> lookup_op(const OpMap<T> &map, const Function &fun) {
     auto key = gen_key(fun, PassParams::SEPARATE);
-    auto pos = map.find(key);
-    if (pos != map.end()) {
+    auto pos = map.ops.find(key);
+    if (pos != map.ops.end()) {
         return pos->second;
     }
     return std::nullopt;
 }
 
-void add_op1(std::map<std::string,op1_t> &map, const std::string &expr, op1_t op) {
-    add_op(map, *Function::parse({"a"}, expr), op);
+template <typename T>
+std::optional<std::string> lookup_expr(const OpMap<T> &map, T op) {
+    auto pos = map.exprs.find(op);
+    if (pos != map.exprs.end()) {
+        return pos->second;
+    }
+    return std::nullopt;
+}
+
+void add_op1(OpMap<op1_t> &map, const std::string &expr, op1_t op) {
+    add_op(map, *Function::parse({"a"}, expr), expr, op);
 }
 
-void add_op2(std::map<std::string,op2_t> &map, const std::string &expr, op2_t op) {
-    add_op(map, *Function::parse({"a", "b"}, expr), op);
+void add_op2(OpMap<op2_t> &map, const std::string &expr, op2_t op) {
+    add_op(map, *Function::parse({"a", "b"}, expr), expr, op);
 }
 
-std::map<std::string,op1_t> make_op1_map() {
-    std::map<std::string,op1_t> map;
+OpMap<op1_t> make_op1_map() {
+    OpMap<op1_t> map;
     add_op1(map, "-a",         Neg::f);
     add_op1(map, "!a",         Not::f);
     add_op1(map, "cos(a)",     Cos::f);
@@ -124,8 +141,8 @@ std::map<std::string,op1_t> make_op1_map() {
     return map;
 }
 
-std::map<std::string,op2_t> make_op2_map() {
-    std::map<std::string,op2_t> map;
+OpMap<op2_t> make_op2_map() {
+    OpMap<op2_t> map;
     add_op2(map, "a+b",        Add::f);
     add_op2(map, "a-b",        Sub::f);
     add_op2(map, "a*b",        Mul::f);
@@ -152,16 +169,32 @@ std::map<std::string,op2_t> make_op2_map() {
     return map;
 }
 
+const OpMap<op1_t> &op1_map() {
+    static const OpMap<op1_t> map = make_op1_map();
+    return map;
+}
+
+const OpMap<op2_t> &op2_map() {
+    static const OpMap<op2_t> map = make_op2_map();
+    return map;
+}
+
 } // namespace <unnamed>
 
 std::optional<op1_t> lookup_op1(const Function &fun) {
-    static const std::map<std::string,op1_t> map = make_op1_map();
-    return lookup_op(map, fun);
+    return lookup_op(op1_map(), fun);
 }
 
 std::optional<op2_t> lookup_op2(const Function &fun) {
-    static const std::map<std::string,op2_t> map = make_op2_map();
-    return lookup_op(map, fun);
+    return lookup_op(op2_map(), fun);
+}
+
+std::optional<std::string> lookup_expr1(op1_t op) {
+    return lookup_expr(op1_map(), op);
+}
+
+std::optional<std::string> lookup_expr2(op2_t op) {
+    return lookup_expr(op2_map(), op);
 }
 
 }
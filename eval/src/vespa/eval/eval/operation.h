@@ -2,6 +2,7 @@
 
 #pragma once
 #include <optional>
+#include <string>
 
 namespace vespalib::eval { class Function; }
 
@@ -62,4 +63,8 @@ using op2_t = double (*)(double, double);
 std::optional<op1_t> lookup_op1(const Function &fun);
 std::optional<op2_t> lookup_op2(const Function &fun);
 
+// expression (with parameters "a" and "b") for a known op
+std::optional<std::string> lookup_expr1(op1_t op);
+std::optional<std::string> lookup_expr2(op2_t op);
+
 }
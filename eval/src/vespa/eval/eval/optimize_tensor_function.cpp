@@ -31,6 +31,8 @@
 #include <vespa/eval/instruction/inplace_map_function.h>
 #include <vespa/eval/instruction/vector_from_doubles_function.h>
 #include <vespa/eval/instruction/dense_tensor_create_function.h>
+#include <vespa/eval/instruction/dense_compiled_elementwise_function.h>
+#include <vespa/eval/instruction/dense_join_map_reduce_function.h>
 #include <vespa/eval/instruction/dense_tensor_peek_function.h>
 #include <vespa/eval/instruction/dense_hamming_distance.h>
 #include <vespa/eval/instruction/l2_distance.h>
@@ -102,6 +104,14 @@ const TensorFunction &optimize_for_factory(const ValueBuilderFactory &, const Te
                               child.set(UniversalDotProduct::optimize(child.get(), stash, false));
                           }
                       });
+    run_optimize_pass(root, [&stash](const Child &child)
+                      {
+                          child.set(DenseJoinMapReduceFunction::optimize(child.get(), stash));
+                      });
+    run_optimize_pass(root, [&stash](const Child &child)
+                      {
+                          child.set(DenseCompiledElementwiseFunction::optimize(child.get(), stash));
+                      });
     run_optimize_pass(root, [&stash](const Child &child)
                       {
                           child.set(DenseSimpleExpandFunction::optimize(child.get(), stash));
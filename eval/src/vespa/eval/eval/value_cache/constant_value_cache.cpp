@@ -1,6 +1,10 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "constant_value_cache.h"
+#include "constant_tensor_loader.h"
+#include <vespa/eval/eval/fast_value.h>
+#include <vespa/vespalib/io/file_digest_cache.h>
+#include <vespa/vespalib/stllike/hash_fun.h>
 #include <cassert>
 
 namespace vespalib {
@@ -14,6 +18,32 @@ ConstantValueCache::Token::~Token()
     }
 }
 
+namespace {
+
+struct ContentKey {
+    uint64_t hash;
+    size_t size;
+};
+
+FileDigestCache<ContentKey> &content_keys() {
+    static FileDigestCache<ContentKey> cache([](Memory content) {
+        return ContentKey{xxhash::xxh3_64(content.data, content.size), content.size};
+    });
+    return cache;
+}
+
+}
+
+ConstantValueCache::Cache::Key
+ConstantValueCache::make_key(const std::string &path, const std::string &type)
+{
+    auto content_key = content_keys().get(path);
+    if (content_key.has_value()) {
+        return {"", content_key->hash, content_key->size, type};
+    }
+    return {path, 0, 0, type};
+}
+
 ConstantValueCache::ConstantValueCache(const ConstantValueFactory &factory)
     : _factory(factory),
       _cache(std::make_shared<Cache>())
@@ -25,7 +55,9 @@ ConstantValueCache::~ConstantValueCache() = default;
 ConstantValue::UP
 ConstantValueCache::create(const std::string &path, const std::string &type) const
 {
-    Cache::Key key = std::make_pair(path, type);
+    // hashing large files takes a while; do it before locking (the
+    // hash is memoized by file path, size and modification time)
+    Cache::Key key = make_key(path, type);
     std::lock_guard<std::mutex> guard(_cache->lock);
     auto pos = _cache->cached.find(key);
     if (pos != _cache->cached.end()) {
@@ -38,5 +70,20 @@ ConstantValueCache::create(const std::string &path, const std::string &type) con
     }
 }
 
+size_t
+ConstantValueCache::num_cached() const
+{
+    std::lock_guard<std::mutex> guard(_cache->lock);
+    return _cache->cached.size();
+}
+
+const ConstantValueCache &
+ConstantValueCache::shared_tensor_cache()
+{
+    static ConstantTensorLoader loader(FastValueBuilderFactory::get());
+    static ConstantValueCache cache(loader);
+    return cache;
+}
+
 } // namespace vespalib::eval
 } // namespace vespalib
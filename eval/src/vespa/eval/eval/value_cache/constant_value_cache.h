@@ -7,6 +7,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <tuple>
 
 namespace vespalib {
 namespace eval {
@@ -15,14 +16,21 @@ namespace eval {
  * A cache enabling clients to share the constant values created by an
  * underlying factory. The returned wrappers are used to ensure
  * appropriate lifetime of created values. Used values are kept in the
- * cache and unused values are evicted from the cache.
+ * cache and unused values are evicted from the cache. Values loaded
+ * from files are identified by the content of the file (hash and
+ * size) rather than its path, so the same constant distributed as
+ * different files (typically for different schemas, or for different
+ * config generations) is only loaded once. The content hash of a file
+ * is memoized by path, file size and modification time.
  **/
 class ConstantValueCache : public ConstantValueFactory
 {
 private:
     struct Cache {
         using SP = std::shared_ptr<Cache>;
-        using Key = std::pair<std::string, std::string>;
+        // (path, content hash, content size, type); path is only used
+        // when the content could not be read
+        using Key = std::tuple<std::string, uint64_t, size_t, std::string>;
         struct Value {
             size_t num_refs;
             ConstantValue::UP const_value;
@@ -34,6 +42,8 @@ private:
         Map cached;
     };
 
+    static Cache::Key make_key(const std::string &path, const std::string &type);
+
     struct Token : ConstantValue {
         Cache::SP cache;
         Cache::Map::iterator entry;
@@ -51,6 +61,15 @@ public:
     ConstantValueCache(const ConstantValueFactory &factory);
     ConstantValue::UP create(const std::string &path, const std::string &type) const override;
     ~ConstantValueCache() override;
+    size_t num_cached() const;
+
+    /**
+     * Process-wide cache of constant tensors loaded from file (see
+     * ConstantTensorLoader) using FastValueBuilderFactory. Used to
+     * share constants between all users in the process; like
+     * different document types.
+     **/
+    static const ConstantValueCache &shared_tensor_cache();
 };
 
 } // namespace vespalib::eval
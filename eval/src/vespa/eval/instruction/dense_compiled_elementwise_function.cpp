@@ -0,0 +1,246 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "dense_compiled_elementwise_function.h"
+#include <vespa/eval/eval/value.h>
+#include <vespa/eval/eval/function.h>
+#include <vespa/eval/eval/operation.h>
+#include <vespa/eval/eval/llvm/compile_cache.h>
+#include <vespa/vespalib/objects/objectvisitor.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/typify.h>
+#include <vespa/vespalib/util/unconstify_span.h>
+#include <algorithm>
+
+namespace vespalib::eval {
+
+using Child = TensorFunction::Child;
+using namespace tensor_function;
+using vespalib::make_string_short::fmt;
+
+namespace {
+
+// number of cells converted to function parameters at a time
+constexpr size_t block_size = 64;
+
+using Self = DenseCompiledElementwiseFunction::Self;
+
+template <typename CT>
+void my_copy_param(TypedCells cells, size_t offset, size_t n, double *dst, size_t stride) {
+    auto src = cells.unsafe_typify<CT>();
+    for (size_t i = 0; i < n; ++i) {
+        dst[i * stride] = double(src[offset + i]);
+    }
+}
+
+struct MyCopyParam {
+    template <typename CT>
+    static auto invoke() { return my_copy_param<CT>; }
+};
+
+template <typename OCT>
+void my_compiled_elementwise_op(InterpretedFunction::State &state, uint64_t param) {
+    const Self &self = unwrap_param<Self>(param);
+    size_t num_params = self.copy_params.size();
+    std::span<OCT> dst_cells = (self.inplace_param == Self::npos)
+        ? state.stash.create_uninitialized_array<OCT>(self.result_size)
+        : unconstify(state.peek(num_params - 1 - self.inplace_param).cells().typify<OCT>());
+    double *params = state.stash.create_uninitialized_array<double>(num_params * block_size).data();
+    for (size_t k = 0; k < num_params; ++k) {
+        if (self.copy_params[k] == nullptr) {
+            double value = state.peek(num_params - 1 - k).as_double();
+            for (size_t i = 0; i < block_size; ++i) {
+                params[i * num_params + k] = value;
+            }
+        }
+    }
+    for (size_t offset = 0; offset < self.result_size; offset += block_size) {
+        size_t n = std::min(block_size, self.result_size - offset);
+        for (size_t k = 0; k < num_params; ++k) {
+            if (self.copy_params[k] != nullptr) {
+                self.copy_params[k](state.peek(num_params - 1 - k).cells(), offset, n, params + k, num_params);
+            }
+        }
+        // all parameters for the block are copied before any result cell is written
+        for (size_t i = 0; i < n; ++i) {
+            dst_cells[offset + i] = OCT(self.function(params + i * num_params));
+        }
+    }
+    state.pop_n_push(num_params, state.stash.create<DenseValueView>(self.result_type, TypedCells(dst_cells)));
+}
+
+struct MyCompiledElementwiseOp {
+    template <typename OCT>
+    static auto invoke() { return my_compiled_elementwise_op<OCT>; }
+};
+
+bool is_target(const ValueType &type) {
+    return (type.is_dense() && !type.is_double());
+}
+
+// Collects the leaves and the expression of a tree of fusable
+// operations. Leaves are named p0, p1, ... in the order they are
+// found, which is also the order they will be evaluated in.
+struct Fusion {
+    const ValueType &type;
+    std::vector<Child> leaves;
+    size_t num_ops;
+    explicit Fusion(const ValueType &type_in) : type(type_in), leaves(), num_ops(0) {}
+
+    std::string add_leaf(const TensorFunction &node) {
+        leaves.emplace_back(node);
+        return fmt("p%zu", leaves.size() - 1);
+    }
+
+    // expression for 'fun' with each parameter replaced by an argument
+    static std::string subst(const Function &fun, const std::vector<std::string> &args) {
+        nodes::DumpContext ctx(args);
+        return fun.root().dump(ctx);
+    }
+    static std::string subst(const std::vector<std::string> &params, const std::string &expr,
+                             const std::vector<std::string> &args)
+    {
+        std::vector<std::string> wrapped;
+        for (const auto &arg: args) {
+            wrapped.push_back("(" + arg + ")");
+        }
+        return subst(*Function::parse(params, expr), wrapped);
+    }
+
+    bool is_operand(const TensorFunction &node) const {
+        return (node.result_type().is_double() ||
+                (is_target(node.result_type()) && (node.result_type().dimensions() == type.dimensions())));
+    }
+
+    std::string fuse_child(const TensorFunction &node) {
+        if (!node.result_type().is_double() && is_operand(node)) {
+            return fuse(node);
+        }
+        return add_leaf(node);
+    }
+
+    std::string fuse(const TensorFunction &node) {
+        if (auto map = as<Map>(node)) {
+            if (auto expr = operation::lookup_expr1(map->function())) {
+                ++num_ops;
+                return subst({"a"}, expr.value(), {fuse_child(map->child())});
+            }
+        } else if (auto join = as<Join>(node)) {
+            if (auto expr = operation::lookup_expr2(join->function())) {
+                if (is_operand(join->lhs()) && is_operand(join->rhs())) {
+                    ++num_ops;
+                    auto lhs = fuse_child(join->lhs());
+                    auto rhs = fuse_child(join->rhs());
+                    return subst({"a", "b"}, expr.value(), {lhs, rhs});
+                }
+            }
+        } else if (auto fused = as<DenseCompiledElementwiseFunction>(node)) {
+            std::vector<Child::CREF> children;
+            fused->push_children(children);
+            std::vector<std::string> args;
+            for (const Child &child: children) {
+                args.push_back(add_leaf(child.get()));
+            }
+            num_ops += fused->num_ops();
+            return subst(fused->function(), args);
+        }
+        return add_leaf(node);
+    }
+};
+
+} // namespace vespalib::eval::<unnamed>
+
+Self::Self(const ValueType &result_type_in, DenseCompiledElementwiseFunction::array_fun_t function_in,
+           std::vector<DenseCompiledElementwiseFunction::copy_fun_t> copy_params_in, size_t inplace_param_in)
+    : result_type(result_type_in),
+      result_size(result_type_in.dense_subspace_size()),
+      function(function_in),
+      copy_params(std::move(copy_params_in)),
+      inplace_param(inplace_param_in)
+{
+}
+
+Self::~Self() = default;
+
+DenseCompiledElementwiseFunction::DenseCompiledElementwiseFunction(const ValueType &res_type, std::vector<Child> children,
+                                                                   std::shared_ptr<Function const> function, size_t num_ops)
+    : TensorFunction(),
+      _result_type(res_type),
+      _children(std::move(children)),
+      _function(std::move(function)),
+      _num_ops(num_ops)
+{
+}
+
+DenseCompiledElementwiseFunction::~DenseCompiledElementwiseFunction() = default;
+
+void
+DenseCompiledElementwiseFunction::push_children(std::vector<Child::CREF> &target) const
+{
+    for (const Child &c : _children) {
+        target.emplace_back(c);
+    }
+}
+
+size_t
+DenseCompiledElementwiseFunction::inplace_param() const
+{
+    // prefer the last candidate as output due to write recency
+    for (size_t i = _children.size(); i-- > 0; ) {
+        const TensorFunction &child = _children[i].get();
+        if (child.result_is_mutable() && (child.result_type() == result_type())) {
+            return i;
+        }
+    }
+    return Self::npos;
+}
+
+InterpretedFunction::Instruction
+DenseCompiledElementwiseFunction::compile_self(const ValueBuilderFactory &, Stash &stash) const
+{
+    const auto &token = stash.create<CompileCache::Token::UP>(CompileCache::compile(*_function, PassParams::ARRAY));
+    std::vector<copy_fun_t> copy_params;
+    for (const Child &child : _children) {
+        const ValueType &type = child.get().result_type();
+        if (type.is_double()) {
+            copy_params.push_back(nullptr);
+        } else {
+            copy_params.push_back(typify_invoke<1,TypifyCellType,MyCopyParam>(type.cell_type()));
+        }
+    }
+    const auto &self = stash.create<Self>(result_type(), token->get().get_function(), std::move(copy_params), inplace_param());
+    auto op = typify_invoke<1,TypifyCellType,MyCompiledElementwiseOp>(result_type().cell_type());
+    return InterpretedFunction::Instruction(op, wrap_param<Self>(self));
+}
+
+void
+DenseCompiledElementwiseFunction::visit_self(vespalib::ObjectVisitor &visitor) const
+{
+    TensorFunction::visit_self(visitor);
+    visitor.visitString("function", _function->dump());
+    visitor.visitInt("num_ops", _num_ops);
+}
+
+const TensorFunction &
+DenseCompiledElementwiseFunction::optimize(const TensorFunction &expr, Stash &stash)
+{
+    if (!is_target(expr.result_type()) || !(as<Map>(expr) || as<Join>(expr))) {
+        return expr;
+    }
+    Fusion fusion(expr.result_type());
+    auto str = fusion.fuse(expr);
+    if (fusion.num_ops < 2) {
+        return expr;
+    }
+    std::vector<std::string> params;
+    for (size_t i = 0; i < fusion.leaves.size(); ++i) {
+        params.push_back(fmt("p%zu", i));
+    }
+    auto function = Function::parse(params, str);
+    if (function->has_error()) {
+        return expr;
+    }
+    return stash.create<DenseCompiledElementwiseFunction>(expr.result_type(), std::move(fusion.leaves),
+                                                          std::move(function), fusion.num_ops);
+}
+
+} // namespace vespalib::eval
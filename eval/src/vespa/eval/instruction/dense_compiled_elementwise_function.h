@@ -0,0 +1,58 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/tensor_function.h>
+
+namespace vespalib::eval {
+
+/**
+ * Tensor function fusing a tree of elementwise map and join
+ * operations (using known operations only) on dense tensors with
+ * equal dimensions into a single scalar function compiled with
+ * LLVM. The leaves of the tree become the children of this function;
+ * the compiled function is called once per output cell with the
+ * matching cell of each tensor child and the value of each number
+ * child as parameters. This avoids allocating and traversing
+ * intermediate tensors for each operation in the tree. The cells
+ * of a mutable tensor child with the same type as the result will be
+ * overwritten with the result.
+ **/
+class DenseCompiledElementwiseFunction : public TensorFunction
+{
+public:
+    // copy n cells starting at offset into dst with the given stride
+    using copy_fun_t = void (*)(TypedCells cells, size_t offset, size_t n, double *dst, size_t stride);
+    using array_fun_t = double (*)(const double *params);
+    struct Self {
+        ValueType result_type;
+        size_t result_size;
+        array_fun_t function;
+        std::vector<copy_fun_t> copy_params; // nullptr for number parameters
+        size_t inplace_param; // parameter whose cells are overwritten, npos if none
+        static constexpr size_t npos = -1;
+        Self(const ValueType &result_type_in, array_fun_t function_in,
+             std::vector<copy_fun_t> copy_params_in, size_t inplace_param_in);
+        ~Self();
+    };
+private:
+    ValueType _result_type;
+    std::vector<Child> _children;
+    std::shared_ptr<Function const> _function;
+    size_t _num_ops;
+public:
+    DenseCompiledElementwiseFunction(const ValueType &res_type, std::vector<Child> children,
+                                     std::shared_ptr<Function const> function, size_t num_ops);
+    ~DenseCompiledElementwiseFunction() override;
+    const ValueType &result_type() const override { return _result_type; }
+    const Function &function() const { return *_function; }
+    size_t num_ops() const { return _num_ops; }
+    size_t inplace_param() const;
+    void push_children(std::vector<Child::CREF> &children) const override;
+    InterpretedFunction::Instruction compile_self(const ValueBuilderFactory &factory, Stash &stash) const override;
+    bool result_is_mutable() const override { return true; }
+    void visit_self(vespalib::ObjectVisitor &visitor) const override;
+    static const TensorFunction &optimize(const TensorFunction &expr, Stash &stash);
+};
+
+} // namespace vespalib::eval
@@ -0,0 +1,140 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "dense_join_map_reduce_function.h"
+#include "dense_join_reduce_plan.h"
+#include <vespa/eval/eval/value.h>
+#include <vespa/eval/eval/visit_stuff.h>
+#include <vespa/vespalib/objects/objectvisitor.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/typify.h>
+#include <algorithm>
+#include <cassert>
+
+namespace vespalib::eval {
+
+using namespace tensor_function;
+using namespace instruction;
+
+namespace {
+
+struct JoinMapReduceParam {
+    ValueType res_type;
+    DenseJoinReducePlan plan;
+    join_fun_t join_fun;
+    std::vector<map_fun_t> map_funs;
+    JoinMapReduceParam(const ValueType &res_type_in, const ValueType &lhs_type, const ValueType &rhs_type,
+                       join_fun_t join_fun_in, std::vector<map_fun_t> map_funs_in)
+      : res_type(res_type_in),
+        plan(lhs_type, rhs_type, res_type),
+        join_fun(join_fun_in),
+        map_funs(std::move(map_funs_in))
+    {
+        assert(res_type.is_double() || (res_type.cell_type() == CellType::DOUBLE) ||
+               (res_type.cell_type() == CellType::FLOAT));
+    }
+    ~JoinMapReduceParam();
+};
+JoinMapReduceParam::~JoinMapReduceParam() = default;
+
+template <typename OCT, typename AGGR>
+const Value &make_result(const ValueType &res_type, std::span<const AGGR> aggrs, Stash &stash) {
+    auto dst_cells = stash.create_uninitialized_array<OCT>(aggrs.size());
+    for (size_t i = 0; i < aggrs.size(); ++i) {
+        dst_cells[i] = aggrs[i].result();
+    }
+    return stash.create<DenseValueView>(res_type, TypedCells(dst_cells));
+}
+
+template <typename LCT, typename RCT, typename AGGR>
+void my_join_map_reduce_op(InterpretedFunction::State &state, uint64_t param_in) {
+    const auto &param = unwrap_param<JoinMapReduceParam>(param_in);
+    auto lhs_cells = state.peek(1).cells().typify<LCT>();
+    auto rhs_cells = state.peek(0).cells().typify<RCT>();
+    auto aggrs = state.stash.create_array<AGGR>(param.plan.res_size);
+    auto fun = [&](size_t lhs_idx, size_t rhs_idx, size_t res_idx) {
+        double value = param.join_fun(lhs_cells[lhs_idx], rhs_cells[rhs_idx]);
+        for (map_fun_t map_fun: param.map_funs) {
+            value = map_fun(value);
+        }
+        aggrs[res_idx].sample(value);
+    };
+    param.plan.execute(0, 0, 0, fun);
+    if (param.res_type.is_double()) {
+        state.pop_pop_push(state.stash.create<DoubleValue>(aggrs[0].result()));
+    } else if (param.res_type.cell_type() == CellType::FLOAT) {
+        state.pop_pop_push(make_result<float, AGGR>(param.res_type, aggrs, state.stash));
+    } else {
+        state.pop_pop_push(make_result<double, AGGR>(param.res_type, aggrs, state.stash));
+    }
+}
+
+struct SelectJoinMapReduceOp {
+    template <typename LCT, typename RCT, typename AGGR>
+    static auto invoke() {
+        return my_join_map_reduce_op<LCT, RCT, typename AGGR::template templ<double>>;
+    }
+};
+
+using MyTypify = TypifyValue<TypifyCellType,TypifyAggr>;
+
+} // namespace vespalib::eval::<unnamed>
+
+DenseJoinMapReduceFunction::DenseJoinMapReduceFunction(const ValueType &res_type, const TensorFunction &lhs, const TensorFunction &rhs,
+                                                       join_fun_t join_fun, std::vector<map_fun_t> map_funs, Aggr aggr)
+  : tensor_function::Op2(res_type, lhs, rhs),
+    _join_fun(join_fun),
+    _map_funs(std::move(map_funs)),
+    _aggr(aggr)
+{
+}
+
+DenseJoinMapReduceFunction::~DenseJoinMapReduceFunction() = default;
+
+InterpretedFunction::Instruction
+DenseJoinMapReduceFunction::compile_self(const ValueBuilderFactory &, Stash &stash) const
+{
+    const auto &param = stash.create<JoinMapReduceParam>(result_type(), lhs().result_type(), rhs().result_type(),
+                                                         _join_fun, _map_funs);
+    auto op = typify_invoke<3,MyTypify,SelectJoinMapReduceOp>(lhs().result_type().cell_type(),
+                                                               rhs().result_type().cell_type(),
+                                                               _aggr);
+    return InterpretedFunction::Instruction(op, wrap_param<JoinMapReduceParam>(param));
+}
+
+void
+DenseJoinMapReduceFunction::visit_self(vespalib::ObjectVisitor &visitor) const
+{
+    Op2::visit_self(visitor);
+    ::visit(visitor, "join_function", _join_fun);
+    for (size_t i = 0; i < _map_funs.size(); ++i) {
+        ::visit(visitor, vespalib::make_string("map_functions[%zu]", i), _map_funs[i]);
+    }
+    ::visit(visitor, "aggr", _aggr);
+}
+
+const TensorFunction &
+DenseJoinMapReduceFunction::optimize(const TensorFunction &expr, Stash &stash)
+{
+    auto reduce = as<Reduce>(expr);
+    if (!reduce || aggr::is_complex(reduce->aggr()) ||
+        !(expr.result_type().is_dense() || expr.result_type().is_double()))
+    {
+        return expr;
+    }
+    std::vector<map_fun_t> map_funs;
+    const TensorFunction *node = &reduce->child();
+    while (auto map = as<Map>(*node)) {
+        map_funs.push_back(map->function());
+        node = &map->child();
+    }
+    auto join = as<Join>(*node);
+    if (!join || !join->lhs().result_type().is_dense() || !join->rhs().result_type().is_dense()) {
+        return expr;
+    }
+    // maps were found outermost first, but are applied innermost first
+    std::reverse(map_funs.begin(), map_funs.end());
+    return stash.create<DenseJoinMapReduceFunction>(expr.result_type(), join->lhs(), join->rhs(),
+                                                    join->function(), std::move(map_funs), reduce->aggr());
+}
+
+} // namespace vespalib::eval
@@ -0,0 +1,40 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/tensor_function.h>
+
+namespace vespalib::eval {
+
+/**
+ * Tensor function performing a join of two dense tensors, followed
+ * by any number of map operations, followed by a reduce; all in a
+ * single loop nest (see DenseJoinReducePlan). Each joined cell is
+ * mapped and aggregated into its result cell directly, avoiding the
+ * intermediate tensors produced by the individual operations. Used
+ * for chains not handled by more specific optimizers (like the
+ * different dot product variants).
+ **/
+class DenseJoinMapReduceFunction : public tensor_function::Op2
+{
+public:
+    using join_fun_t = operation::op2_t;
+    using map_fun_t = operation::op1_t;
+private:
+    join_fun_t _join_fun;
+    std::vector<map_fun_t> _map_funs;
+    Aggr _aggr;
+public:
+    DenseJoinMapReduceFunction(const ValueType &res_type, const TensorFunction &lhs, const TensorFunction &rhs,
+                               join_fun_t join_fun, std::vector<map_fun_t> map_funs, Aggr aggr);
+    ~DenseJoinMapReduceFunction() override;
+    join_fun_t join_fun() const { return _join_fun; }
+    const std::vector<map_fun_t> &map_funs() const { return _map_funs; }
+    Aggr aggr() const { return _aggr; }
+    bool result_is_mutable() const override { return true; }
+    InterpretedFunction::Instruction compile_self(const ValueBuilderFactory &factory, Stash &stash) const override;
+    void visit_self(vespalib::ObjectVisitor &visitor) const override;
+    static const TensorFunction &optimize(const TensorFunction &expr, Stash &stash);
+};
+
+} // namespace vespalib::eval
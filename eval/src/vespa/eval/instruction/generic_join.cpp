@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "generic_join.h"
+#include <vespa/eval/eval/fast_value.hpp>
 #include <vespa/eval/eval/inline_operation.h>
 #include <vespa/eval/eval/wrap_param.h>
 #include <vespa/eval/eval/value_builder_factory.h>
@@ -8,6 +9,7 @@
 #include <vespa/vespalib/util/stash.h>
 #include <vespa/vespalib/util/typify.h>
 #include <vespa/vespalib/util/visit_ranges.h>
+#include <algorithm>
 #include <cassert>
 
 using namespace vespalib::eval::tensor_function;
@@ -33,6 +35,20 @@ generic_mixed_join(const Value &lhs, const Value &rhs, const JoinParam &param)
                       };
     auto lhs_cells = lhs.cells().typify<LCT>();
     auto rhs_cells = rhs.cells().typify<RCT>();
+    if (param.sparse_plan.is_full_overlap() && are_fast(lhs.index(), rhs.index())) {
+        const auto &lhs_map = as_fast(lhs.index()).map;
+        const auto &rhs_map = as_fast(rhs.index()).map;
+        if (FastAddrMap::should_merge(lhs_map, rhs_map)) {
+            size_t expected_subspaces = std::min(lhs_map.size(), rhs_map.size());
+            auto builder = param.factory.create_transient_value_builder<OCT>(param.res_type, param.sparse_plan.sources.size(), param.dense_plan.out_size, expected_subspaces);
+            FastAddrMap::merge(lhs_map, rhs_map, [&](size_t lhs_subspace, size_t rhs_subspace) {
+                        dense_join(lhs_cells.data() + param.dense_plan.lhs_size * lhs_subspace,
+                                   rhs_cells.data() + param.dense_plan.rhs_size * rhs_subspace,
+                                   builder->add_subspace(lhs_map.get_addr(lhs_subspace)).data());
+                    });
+            return builder->build(std::move(builder));
+        }
+    }
     SparseJoinState sparse(param.sparse_plan, lhs.index(), rhs.index());
     size_t expected_subspaces = sparse.first_index.size();
     if (param.sparse_plan.lhs_overlap.empty() && param.sparse_plan.rhs_overlap.empty()) {
@@ -255,6 +271,17 @@ SparseJoinPlan::should_forward_rhs_index() const
     return (sources.size() > 0);
 }
 
+bool
+SparseJoinPlan::is_full_overlap() const
+{
+    for (Source src: sources) {
+        if (src != Source::BOTH) {
+            return false;
+        }
+    }
+    return (sources.size() > 0);
+}
+
 SparseJoinPlan::~SparseJoinPlan() = default;
 
 //-----------------------------------------------------------------------------
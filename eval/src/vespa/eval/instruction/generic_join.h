@@ -64,6 +64,7 @@ struct SparseJoinPlan {
     SmallVector<size_t> rhs_overlap;
     bool should_forward_lhs_index() const;
     bool should_forward_rhs_index() const;
+    bool is_full_overlap() const;
     SparseJoinPlan(const ValueType &lhs_type, const ValueType &rhs_type);
     explicit SparseJoinPlan(size_t num_mapped_dims); // full overlap plan
     ~SparseJoinPlan();
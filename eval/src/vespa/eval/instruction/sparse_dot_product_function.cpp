@@ -40,6 +40,12 @@ double my_fast_sparse_dot_product(const FastAddrMap *small_map, const FastAddrMa
                                   const CT *small_cells, const CT *big_cells)
 {
     double result = 0.0;
+    if (FastAddrMap::should_merge(*small_map, *big_map)) {
+        FastAddrMap::merge(*small_map, *big_map, [&](size_t a_subspace, size_t b_subspace) {
+                    result += (small_cells[a_subspace] * big_cells[b_subspace]);
+                });
+        return result;
+    }
     if (big_map->size() < small_map->size()) {
         std::swap(small_map, big_map);
         std::swap(small_cells, big_cells);
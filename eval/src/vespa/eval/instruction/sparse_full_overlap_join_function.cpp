@@ -4,6 +4,7 @@
 #include "generic_join.h"
 #include <vespa/eval/eval/fast_value.hpp>
 #include <vespa/vespalib/util/typify.h>
+#include <algorithm>
 
 namespace vespalib::eval {
 
@@ -44,11 +45,34 @@ const Value &my_fast_sparse_full_overlap_join(const FastAddrMap &lhs_map, const
     return result;
 }
 
+template <typename CT, typename Fun, bool single_dim>
+const Value &my_fast_sparse_full_overlap_merge(const FastAddrMap &lhs_map, const FastAddrMap &rhs_map,
+                                               const CT *lhs_cells, const CT *rhs_cells,
+                                               const JoinParam &param, Stash &stash)
+{
+    Fun fun(param.function);
+    auto &result = stash.create<FastValue<CT,true>>(param.res_type, lhs_map.addr_size(), 1, std::min(lhs_map.size(), rhs_map.size()));
+    FastAddrMap::merge(lhs_map, rhs_map, [&](size_t lhs_subspace, size_t rhs_subspace) {
+                if constexpr (single_dim) {
+                    result.add_singledim_mapping(lhs_map.labels()[lhs_subspace]);
+                } else {
+                    auto lhs_addr = lhs_map.get_addr(lhs_subspace);
+                    result.add_mapping(lhs_addr, FastAddrMap::hash_labels(lhs_addr));
+                }
+                auto cell_value = fun(lhs_cells[lhs_subspace], rhs_cells[rhs_subspace]);
+                result.my_cells.push_back_fast(cell_value);
+            });
+    return result;
+}
+
 template <typename CT, typename Fun, bool single_dim>
 const Value &my_fast_sparse_full_overlap_join_dispatch(const FastAddrMap &lhs_map, const FastAddrMap &rhs_map,
                                                        const CT *lhs_cells, const CT *rhs_cells,
                                                        const JoinParam &param, Stash &stash)
 {
+    if (FastAddrMap::should_merge(lhs_map, rhs_map)) {
+        return my_fast_sparse_full_overlap_merge<CT,Fun,single_dim>(lhs_map, rhs_map, lhs_cells, rhs_cells, param, stash);
+    }
     return (rhs_map.size() < lhs_map.size())
         ? my_fast_sparse_full_overlap_join<CT,SwapArgs2<Fun>,single_dim>(rhs_map, lhs_map, rhs_cells, lhs_cells, param, stash)
         : my_fast_sparse_full_overlap_join<CT,Fun,single_dim>(lhs_map, rhs_map, lhs_cells, rhs_cells, param, stash);
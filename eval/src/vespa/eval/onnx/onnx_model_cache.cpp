@@ -1,6 +1,9 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "onnx_model_cache.h"
+#include <vespa/vespalib/io/file_digest_cache.h>
+#include <vespa/vespalib/stllike/hash_fun.h>
+#include <string_view>
 
 namespace vespalib::eval {
 
@@ -16,14 +19,59 @@ OnnxModelCache::release(Map::iterator entry)
     }
 }
 
+namespace {
+
+struct ContentKey {
+    uint64_t hash;
+    size_t size;
+    bool may_use_external_data;
+};
+
+// External tensor data is referenced by a "location" entry
+// (StringStringEntryProto with key "location") in onnx models. Looking
+// for it may give false positives, which only prevents sharing.
+bool may_use_external_data(Memory content) {
+    if (Onnx::is_ort_format(content.data, content.size)) {
+        return false;
+    }
+    constexpr std::string_view location_entry("\x0a\x08location", 10);
+    return (content.make_stringview().find(location_entry) != std::string_view::npos);
+}
+
+FileDigestCache<ContentKey> &content_keys() {
+    static FileDigestCache<ContentKey> cache([](Memory content) {
+        return ContentKey{xxhash::xxh3_64(content.data, content.size), content.size, may_use_external_data(content)};
+    });
+    return cache;
+}
+
+}
+
+OnnxModelCache::Key
+OnnxModelCache::make_key(const std::string &model_file)
+{
+    auto content_key = content_keys().get(model_file);
+    if (!content_key.has_value()) {
+        return Key{0, 0, model_file};
+    }
+    // the external data files are resolved relative to the model
+    // file; such models are only shared when loaded from the same path
+    return Key{content_key->hash, content_key->size,
+               content_key->may_use_external_data ? model_file : std::string()};
+}
+
 OnnxModelCache::Token::UP
 OnnxModelCache::load(const std::string &model_file)
 {
+    // hashing large models takes a while; do it before locking (the
+    // hash is memoized by file path, size and modification time)
+    Key key = make_key(model_file);
     std::lock_guard<std::mutex> guard(_lock);
-    auto pos = _cached.find(model_file);
+    auto pos = _cached.find(key);
     if (pos == _cached.end()) {
         auto model = std::make_unique<Onnx>(model_file, Onnx::Optimize::ENABLE);
-        auto res = _cached.emplace(model_file, std::move(model));
+        auto res = _cached.emplace(std::piecewise_construct, std::forward_as_tuple(key),
+                                   std::forward_as_tuple(model_file, std::move(model)));
         assert(res.second);
         pos = res.first;
     }
@@ -48,4 +96,16 @@ OnnxModelCache::count_refs()
     return refs;
 }
 
+std::vector<OnnxModelCache::ModelInfo>
+OnnxModelCache::list_models()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    std::vector<ModelInfo> result;
+    for (const auto &entry: _cached) {
+        result.push_back(ModelInfo{entry.second.file, entry.first.size,
+                                   entry.second.num_refs, entry.second.model->weights_are_mapped()});
+    }
+    return result;
+}
+
 }
@@ -3,33 +3,52 @@
 #pragma once
 
 #include "onnx_wrapper.h"
+#include <compare>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 namespace vespalib::eval {
 
 /**
  * Cache used to share loaded onnx models between users. The cache
  * itself will not keep anything alive, but will let you find loaded
- * models that are currently in use by others.
+ * models that are currently in use by others. Models are identified
+ * by the content of the model file (hash and size), not its name;
+ * the same model used by different rank profiles or document types
+ * will share a single session even when loaded from different
+ * files. Models that may use external data files are also identified
+ * by the path of the model file, since the external data is not part
+ * of the content hash. The content hash of a file is memoized by
+ * path, file size and modification time.
  **/
 class OnnxModelCache
 {
 private:
     struct ctor_tag {};
-    using Key = std::string;
+    // (content hash, content size, path); path is only used when the
+    // content could not be read or the model may use external data
+    struct Key {
+        uint64_t hash;
+        size_t size;
+        std::string path;
+        auto operator<=>(const Key &rhs) const = default;
+    };
     struct Value {
         size_t num_refs;
+        std::string file;
         std::unique_ptr<Onnx> model;
-        Value(std::unique_ptr<Onnx> model_in) : num_refs(0), model(std::move(model_in)) {}
+        Value(const std::string &file_in, std::unique_ptr<Onnx> model_in)
+          : num_refs(0), file(file_in), model(std::move(model_in)) {}
         const Onnx &get() { return *model; }
     };
     using Map = std::map<Key,Value>;
     static std::mutex _lock;
     static Map _cached;
 
+    static Key make_key(const std::string &model_file);
     static void release(Map::iterator entry);
 
 public:
@@ -50,9 +69,18 @@ public:
         ~Token() { OnnxModelCache::release(_entry); }
     };
 
+    // information about a cached model (for state exploring)
+    struct ModelInfo {
+        std::string file;    // file the model was first loaded from
+        size_t file_size;
+        size_t num_refs;
+        bool mapped_weights; // weights are used from a mapping of the model file
+    };
+
     static Token::UP load(const std::string &model_file);
     static size_t num_cached();
     static size_t count_refs();
+    static std::vector<ModelInfo> list_models();
 };
 
 }
@@ -4,10 +4,12 @@
 #include <vespa/eval/eval/cell_type.h>
 #include <vespa/eval/eval/dense_cells_value.h>
 #include <vespa/eval/eval/value_type.h>
+#include <vespa/vespalib/io/mapped_file_input.h>
 #include <vespa/vespalib/util/classname.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/typify.h>
 #include <vespa/vespalib/util/unconstify_span.h>
+#include <cstring>
 #include <span>
 #include <type_traits>
 
@@ -85,6 +87,25 @@ struct CreateEmptyOnnxTensor {
 };
 CreateEmptyOnnxTensor create_empty_onnx_tensor;
 
+struct CreateOnnxTensorView {
+    template <typename T> static Ort::Value invoke(const OrtMemoryInfo *memory, Ort::Value &value,
+                                                   const std::vector<int64_t> &sizes, size_t num_cells)
+    {
+        return Ort::Value::CreateTensor<T>(memory, value.GetTensorMutableData<T>(), num_cells, sizes.data(), sizes.size());
+    }
+    // view of the first 'batch_size' entries along the leading dimension of a tensor
+    Ort::Value operator()(const Onnx::TensorType &type, size_t batch_size, const OrtMemoryInfo *memory, Ort::Value &value) {
+        std::vector<int64_t> sizes = type.dimensions;
+        sizes[0] = batch_size;
+        size_t num_cells = 1;
+        for (int64_t size: sizes) {
+            num_cells *= size;
+        }
+        return typify_invoke<1,MyTypify,CreateOnnxTensorView>(type.elements, memory, value, sizes, num_cells);
+    }
+};
+CreateOnnxTensorView create_onnx_tensor_view;
+
 struct CreateVespaTensorRef {
     template <typename T> static Value::UP invoke(const ValueType &type_ref, Ort::Value &value) {
         size_t num_cells = type_ref.dense_subspace_size();
@@ -465,6 +486,42 @@ Onnx::WirePlanner::get_wire_info(const Onnx &model) const
     return info;
 }
 
+bool
+Onnx::WirePlanner::can_batch(const Onnx &model) const
+{
+    std::string batch_dim;
+    auto has_batch_dim = [&batch_dim](const TensorInfo &info) {
+        const auto &dimensions = info.dimensions;
+        if (dimensions.empty() || !dimensions[0].is_symbolic()) {
+            return false;
+        }
+        if (batch_dim.empty()) {
+            batch_dim = dimensions[0].name;
+        }
+        if (dimensions[0].name != batch_dim) {
+            return false;
+        }
+        for (size_t i = 1; i < dimensions.size(); ++i) {
+            if (dimensions[i].is_symbolic() && (dimensions[i].name == batch_dim)) {
+                return false;
+            }
+        }
+        return true;
+    };
+    for (const auto &input: model.inputs()) {
+        if (!has_batch_dim(input)) {
+            return false;
+        }
+    }
+    for (const auto &output: model.outputs()) {
+        if (!has_batch_dim(output)) {
+            return false;
+        }
+    }
+    auto pos = _symbolic_sizes.find(batch_dim);
+    return ((pos != _symbolic_sizes.end()) && (pos->second == 1));
+}
+
 //-----------------------------------------------------------------------------
 
 template <typename T>
@@ -608,6 +665,124 @@ Onnx::EvalContext::get_result(size_t i) const
 
 //-----------------------------------------------------------------------------
 
+template <typename SRC, typename DST>
+void
+Onnx::BatchEvalContext::bind_batch_param(BatchEvalContext &self, size_t idx, size_t slot, const Value &param)
+{
+    auto cells = param.cells().typify<SRC>();
+    size_t n = self._param_cells[idx];
+    assert(cells.size() == n);
+    const SRC *src = cells.data();
+    DST *dst = self._param_values[idx].GetTensorMutableData<DST>() + (slot * n);
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = DST(src[i]);
+    }
+}
+
+template <typename SRC, typename DST>
+Value::UP
+Onnx::BatchEvalContext::extract_batch_result(BatchEvalContext &self, size_t idx, size_t slot)
+{
+    size_t n = self._result_cells[idx];
+    const SRC *src = self._result_values[idx].GetTensorMutableData<SRC>() + (slot * n);
+    std::vector<DST> cells;
+    cells.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        cells.push_back(DST(src[i]));
+    }
+    return std::make_unique<DenseCellsValue<DST>>(self._wire_info.vespa_outputs[idx], std::move(cells));
+}
+
+struct Onnx::BatchEvalContext::SelectBindParam {
+    template <typename ...Ts> static auto invoke() { return bind_batch_param<Ts...>; }
+    auto operator()(CellType ct, Onnx::ElementType et) {
+        return typify_invoke<2,MyTypify,SelectBindParam>(ct, et);
+    }
+};
+
+struct Onnx::BatchEvalContext::SelectExtractResult {
+    template <typename ...Ts> static auto invoke() { return extract_batch_result<Ts...>; }
+    auto operator()(Onnx::ElementType et, CellType ct) {
+        return typify_invoke<2,MyTypify,SelectExtractResult>(et, ct);
+    }
+};
+
+Onnx::BatchEvalContext::BatchEvalContext(const Onnx &model, const WireInfo &wire_info, size_t max_batch_size)
+    : _model(model),
+      _wire_info(wire_info),
+      _max_batch_size(max_batch_size),
+      _cpu_memory(Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault)),
+      _param_values(),
+      _result_values(),
+      _param_cells(),
+      _result_cells(),
+      _param_binders(),
+      _result_extractors()
+{
+    assert(_max_batch_size > 0);
+    assert(_wire_info.vespa_inputs.size()  == _model.inputs().size());
+    assert(_wire_info.onnx_inputs.size()   == _model.inputs().size());
+    assert(_wire_info.onnx_outputs.size()  == _model.outputs().size());
+    assert(_wire_info.vespa_outputs.size() == _model.outputs().size());
+    for (size_t i = 0; i < _model.inputs().size(); ++i) {
+        const auto &vespa = _wire_info.vespa_inputs[i];
+        Onnx::TensorType onnx = _wire_info.onnx_inputs[i];
+        assert(!onnx.dimensions.empty() && (onnx.dimensions[0] == 1));
+        onnx.dimensions[0] = _max_batch_size;
+        _param_values.push_back(CreateOnnxTensor()(onnx, _alloc));
+        _param_cells.push_back(vespa.dense_subspace_size());
+        _param_binders.push_back(SelectBindParam()(vespa.cell_type(), onnx.elements));
+    }
+    for (size_t i = 0; i < _model.outputs().size(); ++i) {
+        const auto &vespa = _wire_info.vespa_outputs[i];
+        Onnx::TensorType onnx = _wire_info.onnx_outputs[i];
+        assert(!onnx.dimensions.empty() && (onnx.dimensions[0] == 1));
+        onnx.dimensions[0] = _max_batch_size;
+        _result_values.push_back(CreateOnnxTensor()(onnx, _alloc));
+        _result_cells.push_back(vespa.dense_subspace_size());
+        _result_extractors.push_back(SelectExtractResult()(onnx.elements, vespa.cell_type()));
+    }
+}
+
+Onnx::BatchEvalContext::~BatchEvalContext() = default;
+
+void
+Onnx::BatchEvalContext::bind_param(size_t i, size_t slot, const Value &param)
+{
+    assert(slot < _max_batch_size);
+    _param_binders[i](*this, i, slot, param);
+}
+
+void
+Onnx::BatchEvalContext::eval(size_t batch_size)
+{
+    assert((batch_size > 0) && (batch_size <= _max_batch_size));
+    std::vector<Ort::Value> param_views;
+    param_views.reserve(_param_values.size());
+    for (size_t i = 0; i < _param_values.size(); ++i) {
+        param_views.push_back(create_onnx_tensor_view(_wire_info.onnx_inputs[i], batch_size, _cpu_memory, _param_values[i]));
+    }
+    std::vector<Ort::Value> result_views;
+    result_views.reserve(_result_values.size());
+    for (size_t i = 0; i < _result_values.size(); ++i) {
+        result_views.push_back(create_onnx_tensor_view(_wire_info.onnx_outputs[i], batch_size, _cpu_memory, _result_values[i]));
+    }
+    auto &session = const_cast<Ort::Session&>(_model._session);
+    Ort::RunOptions run_opts(nullptr);
+    session.Run(run_opts,
+                _model._input_name_refs.data(), param_views.data(), param_views.size(),
+                _model._output_name_refs.data(), result_views.data(), result_views.size());
+}
+
+Value::UP
+Onnx::BatchEvalContext::extract_result(size_t i, size_t slot)
+{
+    assert(slot < _max_batch_size);
+    return _result_extractors[i](*this, i, slot);
+}
+
+//-----------------------------------------------------------------------------
+
 Ort::AllocatorWithDefaultOptions Onnx::_alloc;
 
 Onnx::Shared::Shared()
@@ -649,8 +824,16 @@ Onnx::extract_meta_data()
     }
 }
 
+bool
+Onnx::is_ort_format(const void *data, size_t size)
+{
+    // ORT format models are flatbuffers with file identifier 'ORTM'
+    return ((size >= 8) && (memcmp(static_cast<const char *>(data) + 4, "ORTM", 4) == 0));
+}
+
 Onnx::Onnx(const std::string &model_file, Optimize optimize)
     : _shared(Shared::get()),
+      _mapped_model(),
       _options(),
       _session(nullptr),
       _inputs(),
@@ -662,7 +845,19 @@ Onnx::Onnx(const std::string &model_file, Optimize optimize)
     _options.SetInterOpNumThreads(1);
     _options.SetGraphOptimizationLevel(convert_optimize(optimize));
     _options.DisableCpuMemArena();
-    _session = Ort::Session(_shared.env(), model_file.c_str(), _options);
+    auto mapped = std::make_unique<MappedFileInput>(model_file);
+    if (mapped->valid() && is_ort_format(mapped->get().data, mapped->get().size)) {
+        // the mapping must outlive the session
+        _options.AddConfigEntry("session.use_ort_model_bytes_directly", "1");
+        _options.AddConfigEntry("session.use_ort_model_bytes_for_initializers", "1");
+        _session = Ort::Session(_shared.env(), mapped->get().data, mapped->get().size, _options);
+        _mapped_model = std::move(mapped);
+    } else {
+        // onnx models are parsed into memory owned by the session;
+        // load them by name so that external data can be resolved
+        mapped.reset();
+        _session = Ort::Session(_shared.env(), model_file.c_str(), _options);
+    }
     extract_meta_data();
 }
 
@@ -6,10 +6,12 @@
 #include <vespa/eval/eval/value_type.h>
 #include <vespa/eval/eval/value.h>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
+namespace vespalib { class MappedFileInput; }
 namespace vespalib::eval { struct Value; }
 
 namespace vespalib::eval {
@@ -94,6 +96,10 @@ public:
         void prepare_output_types(const Onnx &model);
         ValueType make_output_type(const TensorInfo &onnx_out) const;
         WireInfo get_wire_info(const Onnx &model) const;
+        // can the model be evaluated for several independent sets of
+        // inputs at once (see BatchEvalContext); all inputs and outputs
+        // must have the same leading symbolic dimension, bound to size 1
+        bool can_batch(const Onnx &model) const;
     };
 
     // evaluation context; use one per thread and keep model/wire_info alive
@@ -137,6 +143,50 @@ public:
         const Value &get_result(size_t i) const;
     };
 
+    // evaluation context for several independent evaluations stacked
+    // along the leading (batch) dimension of all inputs and outputs;
+    // the wire info must be planned with the batch dimension bound to
+    // size 1 (see WirePlanner::can_batch). Parameters are bound per
+    // batch slot, and the results of each slot are extracted as
+    // separate values after eval. Use one per thread and keep
+    // model/wire_info alive.
+    class BatchEvalContext {
+    private:
+        using param_fun_t = void (*)(BatchEvalContext &, size_t i, size_t slot, const Value &);
+        using result_fun_t = Value::UP (*)(BatchEvalContext &, size_t i, size_t slot);
+
+        const Onnx                  &_model;
+        const WireInfo              &_wire_info;
+        size_t                       _max_batch_size;
+        Ort::MemoryInfo              _cpu_memory;
+        std::vector<Ort::Value>      _param_values;
+        std::vector<Ort::Value>      _result_values;
+        std::vector<size_t>          _param_cells;
+        std::vector<size_t>          _result_cells;
+        std::vector<param_fun_t>     _param_binders;
+        std::vector<result_fun_t>    _result_extractors;
+
+        template <typename SRC, typename DST>
+        static void bind_batch_param(BatchEvalContext &self, size_t idx, size_t slot, const Value &param);
+
+        template <typename SRC, typename DST>
+        static Value::UP extract_batch_result(BatchEvalContext &self, size_t idx, size_t slot);
+
+    public:
+        struct SelectBindParam;
+        struct SelectExtractResult;
+
+        BatchEvalContext(const Onnx &model, const WireInfo &wire_info, size_t max_batch_size);
+        ~BatchEvalContext();
+        size_t num_params() const { return _param_values.size(); }
+        size_t num_results() const { return _result_values.size(); }
+        size_t max_batch_size() const { return _max_batch_size; }
+        void bind_param(size_t i, size_t slot, const Value &param);
+        // evaluate the model for the first 'batch_size' slots
+        void eval(size_t batch_size);
+        Value::UP extract_result(size_t i, size_t slot);
+    };
+
 private:
     // common stuff shared between model sessions
     class Shared {
@@ -150,21 +200,27 @@ private:
 
     static Ort::AllocatorWithDefaultOptions _alloc;
 
-    Shared                   &_shared;
-    Ort::SessionOptions       _options;
-    Ort::Session              _session;
-    std::vector<TensorInfo>   _inputs;
-    std::vector<TensorInfo>   _outputs;
-    std::vector<const char *> _input_name_refs;
-    std::vector<const char *> _output_name_refs;
+    Shared                          &_shared;
+    std::unique_ptr<MappedFileInput> _mapped_model;
+    Ort::SessionOptions              _options;
+    Ort::Session                     _session;
+    std::vector<TensorInfo>          _inputs;
+    std::vector<TensorInfo>          _outputs;
+    std::vector<const char *>        _input_name_refs;
+    std::vector<const char *>        _output_name_refs;
 
     void extract_meta_data() __attribute__((noinline));
 
 public:
+    // Models in ORT format are memory-mapped, and their weights are
+    // used directly from the (shared, read-only) file mapping instead
+    // of being copied into memory owned by the session.
     Onnx(const std::string &model_file, Optimize optimize);
     ~Onnx();
     const std::vector<TensorInfo> &inputs() const { return _inputs; }
     const std::vector<TensorInfo> &outputs() const { return _outputs; }
+    bool weights_are_mapped() const { return bool(_mapped_model); }
+    static bool is_ort_format(const void *data, size_t size);
 };
 
 }
@@ -168,6 +168,8 @@ public enum SearchNodeMetrics implements VespaMetrics {
     CONTENT_PROTON_TRANSACTIONLOG_ENTRIES("content.proton.transactionlog.entries", Unit.RECORD, "The current number of entries in the transaction log"),
     CONTENT_PROTON_TRANSACTIONLOG_DISK_USAGE("content.proton.transactionlog.disk_usage", Unit.BYTE, "The disk usage (in bytes) of the transaction log"),
     CONTENT_PROTON_TRANSACTIONLOG_REPLAY_TIME("content.proton.transactionlog.replay_time", Unit.SECOND, "The replay time (in seconds) of the transaction log during start-up"),
+    CONTENT_PROTON_TRANSACTIONLOG_GROUP_SYNC_SYNCS("content.proton.transactionlog.group_sync.syncs", Unit.OPERATION, "Number of transaction log file syncs done by group sync"),
+    CONTENT_PROTON_TRANSACTIONLOG_GROUP_SYNC_BATCH_SIZE("content.proton.transactionlog.group_sync.batch_size", Unit.OPERATION, "Number of commits acked per group sync batch"),
 
     // document store
     CONTENT_PROTON_DOCUMENTDB_READY_DOCUMENT_STORE_DISK_USAGE("content.proton.documentdb.ready.document_store.disk_usage", Unit.BYTE, "Disk space usage in bytes"),
@@ -236,6 +238,8 @@ public enum SearchNodeMetrics implements VespaMetrics {
     CONTENT_PROTON_DOCUMENTDB_MATCHING_DOCS_RERANKED("content.proton.documentdb.matching.docs_reranked", Unit.DOCUMENT, "Number of documents re-ranked (second phase)"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_QUERIES("content.proton.documentdb.matching.rank_profile.queries", Unit.QUERY, "Number of queries executed"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_SOFT_DOOMED_QUERIES("content.proton.documentdb.matching.rank_profile.soft_doomed_queries", Unit.QUERY, "Number of queries hitting the soft timeout"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_MEMOIZATION_HITS("content.proton.documentdb.matching.rank_profile.memoization_hits", Unit.OPERATION, "Number of memoized rank feature lookups finding a cached value"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_MEMOIZATION_MISSES("content.proton.documentdb.matching.rank_profile.memoization_misses", Unit.OPERATION, "Number of memoized rank feature lookups calculating a new value"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_SOFT_DOOM_FACTOR("content.proton.documentdb.matching.rank_profile.soft_doom_factor", Unit.FRACTION, "Factor used to compute soft-timeout"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_QUERY_LATENCY("content.proton.documentdb.matching.rank_profile.query_latency", Unit.SECOND, "Total average latency (sec) when matching and ranking a query"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_QUERY_SETUP_TIME("content.proton.documentdb.matching.rank_profile.query_setup_time", Unit.SECOND, "Average time (sec) spent setting up and tearing down queries"),
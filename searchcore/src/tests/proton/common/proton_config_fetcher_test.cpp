@@ -478,13 +478,15 @@ TEST_FF("require that allocation config is propagated",
         allocation.multivaluegrowfactor = 0.15;
         allocation.maxDeadBytesRatio = 0.25;
         allocation.maxDeadAddressSpaceRatio = 0.3;
+        allocation.compactionStepSize = 5000;
     }
     auto config = getDocumentDBConfig(f1, f2);
     {
         auto& alloc_config = config->get_alloc_config();
-        EXPECT_EQUAL(AllocStrategy(growStrategy(20000000), CompactionStrategy(0.25, 0.3), 10000), alloc_config.make_alloc_strategy(SubDbType::READY));
-        EXPECT_EQUAL(AllocStrategy(growStrategy(100000), CompactionStrategy(0.25, 0.3), 10000), alloc_config.make_alloc_strategy(SubDbType::REMOVED));
-        EXPECT_EQUAL(AllocStrategy(growStrategy(30000000), CompactionStrategy(0.25, 0.3), 10000), alloc_config.make_alloc_strategy(SubDbType::NOTREADY));
+        CompactionStrategy compaction_strategy(0.25, 0.3, 1, 0.1, 5000);
+        EXPECT_EQUAL(AllocStrategy(growStrategy(20000000), compaction_strategy, 10000), alloc_config.make_alloc_strategy(SubDbType::READY));
+        EXPECT_EQUAL(AllocStrategy(growStrategy(100000), compaction_strategy, 10000), alloc_config.make_alloc_strategy(SubDbType::REMOVED));
+        EXPECT_EQUAL(AllocStrategy(growStrategy(30000000), compaction_strategy, 10000), alloc_config.make_alloc_strategy(SubDbType::NOTREADY));
     }
 }
 
@@ -3,6 +3,7 @@
 LOG_SETUP("task_runner_test");
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/searchcore/proton/initializer/initializer_task.h>
+#include <vespa/searchcore/proton/initializer/initializer_timeline.h>
 #include <vespa/searchcore/proton/initializer/task_runner.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
@@ -10,6 +11,7 @@ LOG_SETUP("task_runner_test");
 #include <string>
 
 using proton::initializer::InitializerTask;
+using proton::initializer::InitializerTimeline;
 using proton::initializer::TaskRunner;
 
 struct TestLog
@@ -48,6 +50,7 @@ public:
 
     virtual void run() override { _log.append(_name); }
     size_t get_transient_memory_usage() const override { return _transient_memory_usage; }
+    std::string get_name() const override { return _name; }
 };
 
 
@@ -166,6 +169,24 @@ TEST_F("single thread with resource using tasks", Fixture(1))
     EXPECT_EQUAL("BDCAE", job._log->result());
 }
 
+TEST_F("timeline lists tasks in start order with path from root", Fixture(1))
+{
+    TestJob job = TestJob::setupDiamond();
+    f.run(job._root);
+    InitializerTimeline timeline(*job._root);
+    const auto &entries = timeline.entries();
+    ASSERT_EQUAL(4u, entries.size());
+    EXPECT_EQUAL("C/A/D", entries[0].name);
+    EXPECT_EQUAL("C/A", entries[1].name);
+    EXPECT_EQUAL("C/B", entries[2].name);
+    EXPECT_EQUAL("C", entries[3].name);
+    EXPECT_TRUE(entries[0].start == vespalib::duration::zero());
+    for (size_t i = 1; i < entries.size(); ++i) {
+        EXPECT_TRUE(entries[i - 1].start <= entries[i].start);
+    }
+    EXPECT_TRUE(entries[3].start + entries[3].duration <= timeline.elapsed());
+}
+
 TEST_MAIN()
 {
     TEST_RUN_ALL();
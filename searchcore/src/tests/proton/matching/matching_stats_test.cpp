@@ -42,6 +42,21 @@ TEST("requireThatDocCountsAddUp") {
     EXPECT_EQUAL(2u, stats.limited_queries());
 }
 
+TEST("requireThatMemoizationCountsAddUp") {
+    MatchingStats stats;
+    EXPECT_EQUAL(0u, stats.memoizationHits());
+    EXPECT_EQUAL(0u, stats.memoizationMisses());
+    stats.merge_partition(MatchingStats::Partition().memoizationHits(7).memoizationMisses(3), 0);
+    stats.merge_partition(MatchingStats::Partition().memoizationHits(5).memoizationMisses(1), 1);
+    EXPECT_EQUAL(12u, stats.memoizationHits());
+    EXPECT_EQUAL(4u, stats.memoizationMisses());
+    EXPECT_EQUAL(7u, stats.getPartition(0).memoizationHits());
+    EXPECT_EQUAL(1u, stats.getPartition(1).memoizationMisses());
+    stats.add(MatchingStats().memoizationHits(10).memoizationMisses(2));
+    EXPECT_EQUAL(22u, stats.memoizationHits());
+    EXPECT_EQUAL(6u, stats.memoizationMisses());
+}
+
 TEST("requireThatAverageTimesAreRecorded") {
     MatchingStats stats;
     EXPECT_APPROX(0.0, stats.matchTimeAvg(), 0.00001);
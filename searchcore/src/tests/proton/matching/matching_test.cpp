@@ -684,6 +684,27 @@ TEST_F(MatchingTest, require_that_ranking_is_performed_with_multi_threaded_match
     }
 }
 
+TEST_F(MatchingTest, require_that_memoized_rank_feature_lookups_are_counted_in_matching_stats)
+{
+    for (size_t threads = 1; threads <= 4; ++threads) {
+        MyWorld world(shared_state());
+        world.basicSetup();
+        world.set_property(indexproperties::rank::FirstPhase::NAME, "rankingExpression(\"attribute(a3)+1\")");
+        world.set_property(indexproperties::eval::PureFeatureCacheSize::NAME, "10");
+        world.basicResults();
+        SearchRequest::SP request = MyWorld::createSimpleRequest("f1", "spread");
+        SearchReply::UP reply = world.performSearch(*request, threads);
+        EXPECT_EQ(9u, world.matchingStats.docsRanked());
+        // all hits have the same value for a3, calculated once in each match thread ranking hits
+        EXPECT_EQ(9u, world.matchingStats.memoizationHits() + world.matchingStats.memoizationMisses());
+        EXPECT_LE(1u, world.matchingStats.memoizationMisses());
+        EXPECT_GE(threads, world.matchingStats.memoizationMisses());
+        if (threads == 1) {
+            EXPECT_EQ(8u, world.matchingStats.memoizationHits());
+        }
+    }
+}
+
 TEST_F(MatchingTest, require_that_reranking_is_performed_with_multi_threaded_matcher)
  {
     for (size_t threads = 1; threads <= 16; ++threads) {
@@ -16,6 +16,9 @@
 #include <vespa/searchlib/common/serialnum.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/foreground_thread_executor.h>
+#include <vespa/vespalib/util/gate.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/util/buffer.h>
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/testkit/test_master.hpp>
@@ -30,6 +33,9 @@ using storage::spi::Timestamp;
 using vespalib::ConstBufferRef;
 using vespalib::nbostream;
 using vespalib::ForegroundThreadExecutor;
+using vespalib::Gate;
+using vespalib::makeLambdaTask;
+using vespalib::ThreadStackExecutor;
 using namespace proton;
 
 namespace {
@@ -38,15 +44,19 @@ struct MyFeedView : public test::DummyFeedView {
     TestDocRepo repo;
     std::shared_ptr<const DocumentTypeRepo> repo_sp;
     int remove_handled;
+    std::vector<SerialNum> remove_serials;
 
     MyFeedView();
     ~MyFeedView() override;
 
     const std::shared_ptr<const DocumentTypeRepo> &getDocumentTypeRepo() const override { return repo_sp; }
-    void handleRemove(FeedToken , const RemoveOperation &) override { ++remove_handled; }
+    void handleRemove(FeedToken , const RemoveOperation &op) override {
+        ++remove_handled;
+        remove_serials.push_back(op.getSerialNum());
+    }
 };
 
-MyFeedView::MyFeedView() : repo_sp(repo.getTypeRepoSp()), remove_handled(0) {}
+MyFeedView::MyFeedView() : repo_sp(repo.getTypeRepoSp()), remove_handled(0), remove_serials() {}
 MyFeedView::~MyFeedView() = default;
 
 struct MyReplayConfig : IReplayConfig {
@@ -73,6 +83,7 @@ struct Fixture
     bucketdb::BucketDBHandler _bucketDBHandler;
     ReplayThrottlingPolicy _replay_throttling_policy;
     MyIncSerialNum _inc_serial_num;
+    ThreadStackExecutor _decode_executor;
     ReplayTransactionLogState state;
 
     Fixture();
@@ -89,7 +100,9 @@ Fixture::Fixture()
       _bucketDBHandler(_bucketDB),
       _replay_throttling_policy({}),
       _inc_serial_num(9u),
-      state("doctypename", feed_view_ptr, _bucketDBHandler, replay_config, config_store, _replay_throttling_policy, _inc_serial_num)
+      _decode_executor(4),
+      state("doctypename", feed_view_ptr, _bucketDBHandler, replay_config, config_store, _replay_throttling_policy, _inc_serial_num,
+            _decode_executor)
 {
 }
 Fixture::~Fixture() = default;
@@ -102,18 +115,20 @@ struct RemoveOperationContext
     nbostream str;
     std::unique_ptr<Packet> packet;
 
-    explicit RemoveOperationContext(search::SerialNum serial);
+    explicit RemoveOperationContext(search::SerialNum serial, uint32_t num_entries = 1);
     ~RemoveOperationContext();
 };
 
-RemoveOperationContext::RemoveOperationContext(search::SerialNum serial)
+RemoveOperationContext::RemoveOperationContext(search::SerialNum serial, uint32_t num_entries)
     : doc_id("id:ns:doctypename::bar"),
       op(BucketFactory::getBucketId(doc_id), Timestamp(10), doc_id),
       str(), packet(std::make_unique<Packet>(0xf000))
 {
     op.serialize(str);
     ConstBufferRef buf(str.data(), str.wp());
-    packet->add(Packet::Entry(serial, FeedOperation::REMOVE, buf));
+    for (uint32_t i = 0; i < num_entries; ++i) {
+        packet->add(Packet::Entry(serial + i, FeedOperation::REMOVE, buf));
+    }
 }
 RemoveOperationContext::~RemoveOperationContext() = default;
 TEST_F("require that active FeedView can change during replay", Fixture)
@@ -151,4 +166,39 @@ TEST_F("require that replay progress is tracked", Fixture)
     EXPECT_EQUAL(0.5, progress.getProgress());
 }
 
+TEST_F("require that entries decoded in parallel are replayed in serial number order", Fixture)
+{
+    constexpr uint32_t num_entries = 200;
+    RemoveOperationContext opCtx(10, num_entries);
+    TlsReplayProgress progress("test", 9, 9 + num_entries);
+    auto wrap = std::make_shared<PacketWrapper>(*opCtx.packet, &progress);
+    ForegroundThreadExecutor executor;
+
+    f.state.receive(wrap, executor);
+    EXPECT_EQUAL(int(num_entries), f.feed_view1.remove_handled);
+    ASSERT_EQUAL(num_entries, f.feed_view1.remove_serials.size());
+    for (uint32_t i = 0; i < num_entries; ++i) {
+        EXPECT_EQUAL(10u + i, f.feed_view1.remove_serials[i]);
+    }
+    EXPECT_EQUAL(9u + num_entries, progress.getCurrent());
+    EXPECT_EQUAL(1.0, progress.getProgress());
+}
+
+TEST_F("require that replay does not wait for decode tasks that have not started", Fixture)
+{
+    Gate blocked;
+    for (size_t i = 0; i < 4; ++i) {
+        f._decode_executor.execute(makeLambdaTask([&blocked]() { blocked.await(); }));
+    }
+    constexpr uint32_t num_entries = 200;
+    RemoveOperationContext opCtx(10, num_entries);
+    auto wrap = std::make_shared<PacketWrapper>(*opCtx.packet, nullptr);
+    ForegroundThreadExecutor executor;
+
+    f.state.receive(wrap, executor);
+    EXPECT_EQUAL(int(num_entries), f.feed_view1.remove_handled);
+    blocked.countDown();
+    f._decode_executor.sync();
+}
+
 }  // namespace
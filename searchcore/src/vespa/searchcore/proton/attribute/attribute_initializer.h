@@ -54,6 +54,7 @@ public:
 
     AttributeInitializerResult init() const;
     const std::optional<uint64_t>& getCurrentSerialNum() const noexcept { return _currentSerialNum; }
+    const std::string& getName() const noexcept { return _spec.getName(); }
     size_t get_transient_memory_usage() const;
 };
 
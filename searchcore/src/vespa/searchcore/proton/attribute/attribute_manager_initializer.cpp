@@ -47,6 +47,9 @@ public:
     size_t get_transient_memory_usage() const override {
         return _initializer->get_transient_memory_usage();
     }
+    std::string get_name() const override {
+        return "attribute." + _initializer->getName();
+    }
 };
 
 class AttributeManagerInitializerTask : public vespalib::Executor::Task
@@ -168,6 +171,12 @@ AttributeManagerInitializer::AttributeManagerInitializer(SerialNum configSerialN
 
 AttributeManagerInitializer::~AttributeManagerInitializer() = default;
 
+std::string
+AttributeManagerInitializer::get_name() const
+{
+    return "attribute_manager";
+}
+
 void
 AttributeManagerInitializer::run()
 {
@@ -12,6 +12,7 @@
 #include <vespa/searchlib/tensor/i_tensor_attribute.h>
 #include <vespa/searchlib/util/state_explorer_utils.h>
 #include <vespa/vespalib/data/slime/cursor.h>
+#include <vespa/vespalib/util/placement_memory_allocator.h>
 
 using search::AddressSpaceUsage;
 using search::AttributeVector;
@@ -27,6 +28,7 @@ using search::attribute::MultiValueMappingBase;
 using search::attribute::Status;
 using vespalib::AddressSpace;
 using vespalib::MemoryUsage;
+using vespalib::alloc::PlacementMemoryAllocator;
 using namespace vespalib::slime;
 
 namespace proton {
@@ -108,6 +110,17 @@ convertPostingBaseToSlime(const IPostingListAttributeBase &postingBase, Cursor &
     convertMemoryUsageToSlime(memory_usage.bitvectors, cursor.setObject("bitvectors"));
 }
 
+void
+convert_memory_placement_to_slime(const PlacementMemoryAllocator &allocator, Cursor &object)
+{
+    auto stats = allocator.get_stats();
+    object.setString("placement", allocator.get_placement().to_string());
+    object.setLong("allocations", stats.allocations);
+    object.setLong("explicit_huge_page_allocations", stats.explicit_huge_page_allocations);
+    object.setLong("huge_page_fallbacks", stats.huge_page_fallbacks);
+    object.setLong("numa_bind_failures", stats.numa_bind_failures);
+}
+
 std::string
 type_to_string(const Config& cfg)
 {
@@ -185,6 +198,10 @@ AttributeVectorExplorer::get_state_helper(const AttributeVector& attr, const ves
             ObjectInserter tensor_inserter(object, "tensor");
             tensor_attr->get_state(tensor_inserter);
         }
+        const auto* placement_allocator = dynamic_cast<const PlacementMemoryAllocator*>(attr.get_memory_allocator().get());
+        if (placement_allocator) {
+            convert_memory_placement_to_slime(*placement_allocator, object.setObject("memory_placement"));
+        }
         convertChangeVectorToSlime(attr, object.setObject("changeVector"));
         object.setLong("committedDocIdLimit", attr.getCommittedDocIdLimit());
         object.setLong("createSerialNum", attr.getCreateSerialNum());
@@ -55,7 +55,8 @@ EventLogger::transactionLogReplayStart(const string &domainName, SerialNum first
 
 void
 EventLogger::transactionLogReplayProgress(const string &domainName, float progress,
-                                          SerialNum first, SerialNum last, SerialNum current)
+                                          SerialNum first, SerialNum last, SerialNum current,
+                                          double entriesPerSecond)
 {
     JSONStringer jstr;
     jstr.beginObject();
@@ -67,6 +68,7 @@ EventLogger::transactionLogReplayProgress(const string &domainName, float progre
         .appendKey("last").appendInt64(last)
         .appendKey("current").appendInt64(current)
         .endObject();
+    jstr.appendKey("entries_per_second").appendDouble(entriesPerSecond);
     jstr.endObject();
     EV_STATE("transactionlog.replay.progress", jstr.str().c_str() );
 }
@@ -32,7 +32,8 @@ public:
                                              float progress,
                                              SerialNum first,
                                              SerialNum last,
-                                             SerialNum current);
+                                             SerialNum current,
+                                             double entriesPerSecond);
     static void flushInit(const string &name);
     static void flushStart(const string &name,
                            int64_t beforeMemory,
@@ -32,6 +32,12 @@ SummaryManagerInitializer(const search::GrowStrategy &grow,
 
 SummaryManagerInitializer::~SummaryManagerInitializer() = default;
 
+std::string
+SummaryManagerInitializer::get_name() const
+{
+    return "summary_manager";
+}
+
 void
 SummaryManagerInitializer::run()
 {
@@ -42,6 +42,7 @@ public:
                               std::shared_ptr<SummaryManager::SP> result);
     ~SummaryManagerInitializer() override;
     void run() override;
+    std::string get_name() const override;
 };
 
 } // namespace proton
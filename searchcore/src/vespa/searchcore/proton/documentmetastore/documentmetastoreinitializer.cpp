@@ -33,6 +33,12 @@ failedMsg(const char * msg) {
 }
 }
 
+std::string
+DocumentMetaStoreInitializer::get_name() const
+{
+    return "document_meta_store";
+}
+
 void
 DocumentMetaStoreInitializer::run()
 {
@@ -29,6 +29,7 @@ public:
                                  const std::string &docTypeName,
                                  std::shared_ptr<DocumentMetaStore> dms);
     void run() override;
+    std::string get_name() const override;
 };
 
 
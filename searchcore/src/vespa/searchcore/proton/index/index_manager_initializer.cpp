@@ -37,6 +37,12 @@ IndexManagerInitializer(const std::string &baseDir,
 
 IndexManagerInitializer::~IndexManagerInitializer() = default;
 
+std::string
+IndexManagerInitializer::get_name() const
+{
+    return "index_manager";
+}
+
 void
 IndexManagerInitializer::run()
 {
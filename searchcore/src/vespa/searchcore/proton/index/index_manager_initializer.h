@@ -40,6 +40,7 @@ public:
                             std::shared_ptr<searchcorespi::IIndexManager::SP> indexManager);
     ~IndexManagerInitializer() override;
     void run() override;
+    std::string get_name() const override;
 };
 
 } // namespace proton
@@ -6,7 +6,9 @@ namespace proton::initializer {
 
 InitializerTask::InitializerTask()
     : _state(State::BLOCKED),
-      _dependencies()
+      _dependencies(),
+      _run_start(),
+      _run_end()
 {
 }
 
@@ -24,4 +26,10 @@ InitializerTask::get_transient_memory_usage() const
     return 0u;
 }
 
+std::string
+InitializerTask::get_name() const
+{
+    return {};
+}
+
 }
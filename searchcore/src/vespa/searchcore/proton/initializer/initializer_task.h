@@ -1,7 +1,9 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include <vespa/vespalib/util/time.h>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace proton::initializer {
@@ -20,8 +22,10 @@ public:
         DONE
     };
 private:
-    State           _state;
-    List            _dependencies;
+    State                 _state;
+    List                  _dependencies;
+    vespalib::steady_time _run_start;
+    vespalib::steady_time _run_end;
 public:
     InitializerTask();
     virtual ~InitializerTask();
@@ -30,8 +34,15 @@ public:
     void setRunning() { _state = State::RUNNING; }
     void setDone() { _state = State::DONE; }
     void addDependency(SP dependency);
+    // Called by the thread running the task, used for the startup timeline.
+    void set_run_start(vespalib::steady_time now) noexcept { _run_start = now; }
+    void set_run_end(vespalib::steady_time now) noexcept { _run_end = now; }
+    vespalib::steady_time get_run_start() const noexcept { return _run_start; }
+    vespalib::steady_time get_run_end() const noexcept { return _run_end; }
     virtual void run() = 0;
     virtual size_t get_transient_memory_usage() const;
+    // Name used when reporting the startup timeline, tasks without name are not reported.
+    virtual std::string get_name() const;
 };
 
 }
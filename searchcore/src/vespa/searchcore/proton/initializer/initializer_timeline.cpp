@@ -0,0 +1,66 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "initializer_timeline.h"
+#include "initializer_task.h"
+#include <vespa/vespalib/stllike/hash_set.h>
+#include <algorithm>
+
+namespace proton::initializer {
+
+namespace {
+
+struct RunInfo {
+    std::string           name;
+    vespalib::steady_time start;
+    vespalib::steady_time end;
+};
+
+void
+collect(const InitializerTask &task, const std::string &parent_path,
+        vespalib::hash_set<const void *> &visited, std::vector<RunInfo> &result)
+{
+    if (!visited.insert(&task).second) {
+        return;
+    }
+    std::string name = task.get_name();
+    std::string path = name.empty() ? parent_path : (parent_path.empty() ? name : parent_path + "/" + name);
+    if (!name.empty() && task.getState() == InitializerTask::State::DONE) {
+        result.push_back({path, task.get_run_start(), task.get_run_end()});
+    }
+    for (const auto &dep : task.getDependencies()) {
+        collect(*dep, path, visited, result);
+    }
+}
+
+}
+
+InitializerTimeline::InitializerTimeline(const InitializerTask &root)
+    : _entries()
+{
+    std::vector<RunInfo> runs;
+    vespalib::hash_set<const void *> visited;
+    collect(root, "", visited, runs);
+    if (runs.empty()) {
+        return;
+    }
+    std::sort(runs.begin(), runs.end(), [](const auto &lhs, const auto &rhs) { return lhs.start < rhs.start; });
+    vespalib::steady_time first = runs.front().start;
+    _entries.reserve(runs.size());
+    for (const auto &run : runs) {
+        _entries.emplace_back(run.name, run.start - first, run.end - run.start);
+    }
+}
+
+InitializerTimeline::~InitializerTimeline() = default;
+
+vespalib::duration
+InitializerTimeline::elapsed() const noexcept
+{
+    vespalib::duration result = vespalib::duration::zero();
+    for (const auto &entry : _entries) {
+        result = std::max(result, entry.start + entry.duration);
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,40 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/vespalib/util/time.h>
+#include <string>
+#include <vector>
+
+namespace proton::initializer {
+
+class InitializerTask;
+
+/*
+ * Startup timeline for a graph of initializer tasks that has been run,
+ * listing when each named task started and how long it ran. Start times
+ * are relative to the earliest task start. A task is listed with the path
+ * of named tasks depending on it, e.g. "subdb.0.ready/attribute_manager/attribute.foo",
+ * using the first path found from the root task.
+ */
+class InitializerTimeline {
+public:
+    struct Entry {
+        std::string        name;
+        vespalib::duration start;
+        vespalib::duration duration;
+        Entry(std::string name_in, vespalib::duration start_in, vespalib::duration duration_in) noexcept
+            : name(std::move(name_in)),
+              start(start_in),
+              duration(duration_in)
+        {}
+    };
+private:
+    std::vector<Entry> _entries;
+public:
+    explicit InitializerTimeline(const InitializerTask &root);
+    ~InitializerTimeline();
+    const std::vector<Entry> &entries() const noexcept { return _entries; }
+    vespalib::duration elapsed() const noexcept;
+};
+
+}
@@ -77,7 +77,9 @@ TaskRunner::internalRunTask(InitializerTask::SP task, Context::SP context)
     setTaskRunning(*task);
     auto done(makeLambdaTask([this, task, context]() { setTaskDone(*task, context); }));
     _executor.execute(makeLambdaTask([task, context, done(std::move(done))]() mutable
-                                     {   task->run();
+                                     {   task->set_run_start(vespalib::steady_clock::now());
+                                         task->run();
+                                         task->set_run_end(vespalib::steady_clock::now());
                                          context->execute(std::move(done)); }));
 }
 
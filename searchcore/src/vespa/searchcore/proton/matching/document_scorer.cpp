@@ -27,11 +27,24 @@ extractScoreFeature(const RankProgram &rankProgram)
 
 DocumentScorer::DocumentScorer(RankProgram &rankProgram,
                                SearchIterator &searchItr)
-    : _searchItr(searchItr),
+    : _rankProgram(rankProgram),
+      _searchItr(searchItr),
       _scoreFeature(extractScoreFeature(rankProgram))
 {
 }
 
+void
+DocumentScorer::prepare_batch(const TaggedHits &hits)
+{
+    _searchItr.initRange(hits.front().first.first, hits.back().first.first + 1);
+    _rankProgram.begin_batch();
+    for (const auto &hit: hits) {
+        _searchItr.unpack(hit.first.first);
+        _rankProgram.add_to_batch(hit.first.first);
+    }
+    _rankProgram.end_batch();
+}
+
 void
 DocumentScorer::score(TaggedHits &hits)
 {
@@ -40,6 +53,10 @@ DocumentScorer::score(TaggedHits &hits)
     }
     auto sort_on_docid = [](const TaggedHit &a, const TaggedHit &b){ return (a.first.first < b.first.first); };
     std::sort(hits.begin(), hits.end(), sort_on_docid);
+    if (_rankProgram.has_batch_executors()) {
+        // unpack all hits an extra time to let batch executors see them up front
+        prepare_batch(hits);
+    }
     _searchItr.initRange(hits.front().first.first, hits.back().first.first + 1);
     for (auto &hit: hits) {
         hit.first.second = doScore(hit.first.first);
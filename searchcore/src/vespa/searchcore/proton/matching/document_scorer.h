@@ -20,14 +20,18 @@ namespace proton::matching {
  */
 class DocumentScorer
 {
+public:
+    using TaggedHit = IMatchLoopCommunicator::TaggedHit;
+    using TaggedHits = IMatchLoopCommunicator::TaggedHits;
+
 private:
+    search::fef::RankProgram &_rankProgram;
     search::queryeval::SearchIterator &_searchItr;
     search::fef::LazyValue _scoreFeature;
 
-public:
-    using TaggedHit = IMatchLoopCommunicator::TaggedHit;
-    using TaggedHits = IMatchLoopCommunicator::TaggedHits;
+    void prepare_batch(const TaggedHits &hits);
 
+public:
     DocumentScorer(search::fef::RankProgram &rankProgram,
                    search::queryeval::SearchIterator &searchItr);
 
@@ -53,6 +53,12 @@ struct SimpleStrategy {
     }
 };
 
+void add_memoization_stats(MatchingStats::Partition &stats, const RankProgram &rankProgram) {
+    auto memoization = rankProgram.get_memoization_stats();
+    stats.memoizationHits(stats.memoizationHits() + memoization.hits);
+    stats.memoizationMisses(stats.memoizationMisses() + memoization.misses);
+}
+
 LazyValue get_score_feature(const RankProgram &rankProgram) {
     FeatureResolver resolver(rankProgram.get_seeds());
     assert(resolver.num_features() == 1u);
@@ -336,6 +342,7 @@ MatchThread::secondPhase(MatchTools & tools, HitCollector & hits) {
         tools.setup_second_phase(second_phase_profiler.get());
         DocumentScorer scorer(tools.rank_program(), tools.search());
         scorer.score(my_work);
+        add_memoization_stats(thread_stats, tools.rank_program());
     }
     thread_stats.docsReRanked(my_work.size());
     trace->addEvent(5, "Synchronize before rank scaling");
@@ -377,6 +384,7 @@ MatchThread::findMatches(MatchTools &tools)
      * If not you will have deadlock.
      */
     match_loop_helper(tools, hits);
+    add_memoization_stats(thread_stats, tools.rank_program());
     if (tools.has_second_phase_rank()) {
         secondPhase(tools, hits);
     }
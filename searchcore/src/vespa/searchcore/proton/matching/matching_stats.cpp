@@ -27,6 +27,8 @@ MatchingStats::MatchingStats(double prev_soft_doom_factor) noexcept
       _docsRanked(0),
       _docsReRanked(0),
       _softDoomed(0),
+      _memoizationHits(0),
+      _memoizationMisses(0),
       _doomOvertime(),
       _softDoomFactor(prev_soft_doom_factor),
       _querySetupTime(),
@@ -48,6 +50,8 @@ MatchingStats::merge_partition(const Partition &partition, size_t id)
     _docsMatched += partition.docsMatched();
     _docsRanked += partition.docsRanked();
     _docsReRanked += partition.docsReRanked();
+    _memoizationHits += partition.memoizationHits();
+    _memoizationMisses += partition.memoizationMisses();
     _doomOvertime.add(partition._doomOvertime);
     if (partition.softDoomed()) {
         _softDoomed = 1;
@@ -67,6 +71,8 @@ MatchingStats::add(const MatchingStats &rhs) noexcept
     _docsRanked += rhs._docsRanked;
     _docsReRanked += rhs._docsReRanked;
     _softDoomed += rhs.softDoomed();
+    _memoizationHits += rhs._memoizationHits;
+    _memoizationMisses += rhs._memoizationMisses;
     _doomOvertime.add(rhs._doomOvertime);
 
     _querySetupTime.add(rhs._querySetupTime);
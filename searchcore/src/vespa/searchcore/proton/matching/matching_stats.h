@@ -63,6 +63,8 @@ public:
         size_t _docsRanked;
         size_t _docsReRanked;
         size_t _softDoomed;
+        size_t _memoizationHits;
+        size_t _memoizationMisses;
         Avg    _doomOvertime;
         Avg    _active_time;
         Avg    _wait_time;
@@ -74,6 +76,8 @@ public:
               _docsRanked(0),
               _docsReRanked(0),
               _softDoomed(0),
+              _memoizationHits(0),
+              _memoizationMisses(0),
               _doomOvertime(),
               _active_time(),
               _wait_time() { }
@@ -88,6 +92,10 @@ public:
         size_t docsReRanked() const noexcept { return _docsReRanked; }
         Partition &softDoomed(bool v) noexcept { _softDoomed += v ? 1 : 0; return *this; }
         size_t softDoomed() const noexcept { return _softDoomed; }
+        Partition &memoizationHits(size_t value) noexcept { _memoizationHits = value; return *this; }
+        size_t memoizationHits() const noexcept { return _memoizationHits; }
+        Partition &memoizationMisses(size_t value) noexcept { _memoizationMisses = value; return *this; }
+        size_t memoizationMisses() const noexcept { return _memoizationMisses; }
         Partition & doomOvertime(vespalib::duration overtime) noexcept { _doomOvertime.set(vespalib::to_s(overtime)); return *this; }
         vespalib::duration doomOvertime() const noexcept { return vespalib::from_s(_doomOvertime.max()); }
 
@@ -108,6 +116,8 @@ public:
             _docsRanked += rhs._docsRanked;
             _docsReRanked += rhs._docsReRanked;
             _softDoomed += rhs._softDoomed;
+            _memoizationHits += rhs._memoizationHits;
+            _memoizationMisses += rhs._memoizationMisses;
             _doomOvertime.add(rhs._doomOvertime);
 
             _active_time.add(rhs._active_time);
@@ -124,6 +134,8 @@ private:
     size_t                 _docsRanked;
     size_t                 _docsReRanked;
     size_t                 _softDoomed;
+    size_t                 _memoizationHits;
+    size_t                 _memoizationMisses;
     Avg                    _doomOvertime;
     using SoftDoomFactor = vespalib::datastore::AtomicValueWrapper<double>;
     SoftDoomFactor         _softDoomFactor;
@@ -165,6 +177,12 @@ public:
     MatchingStats &softDoomed(size_t value) { _softDoomed = value; return *this; }
     size_t softDoomed() const { return _softDoomed; }
 
+    // lookups in memoized rank features (see search::fef::RankProgram::get_memoization_stats)
+    MatchingStats &memoizationHits(size_t value) { _memoizationHits = value; return *this; }
+    size_t memoizationHits() const { return _memoizationHits; }
+    MatchingStats &memoizationMisses(size_t value) { _memoizationMisses = value; return *this; }
+    size_t memoizationMisses() const { return _memoizationMisses; }
+
     vespalib::duration doomOvertime() const { return vespalib::from_s(_doomOvertime.max()); }
 
     MatchingStats &softDoomFactor(double value) { _softDoomFactor.store_relaxed(value); return *this; }
@@ -147,6 +147,8 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::RankProfileMetrics
       queries("queries", {}, "Number of queries executed", this),
       limitedQueries("limited_queries", {}, "Number of queries limited in match phase", this),
       softDoomedQueries("soft_doomed_queries", {}, "Number of queries hitting the soft timeout", this),
+      memoizationHits("memoization_hits", {}, "Number of memoized rank feature lookups finding a cached value", this),
+      memoizationMisses("memoization_misses", {}, "Number of memoized rank feature lookups calculating a new value", this),
       softDoomFactor("soft_doom_factor", {}, "Factor used to compute soft-timeout", this),
       matchTime("match_time", {}, "Average time (sec) for matching a query (1st phase)", this),
       groupingTime("grouping_time", {}, "Average time (sec) spent on grouping", this),
@@ -196,6 +198,8 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::update(const metri
     queries.inc(stats.queries());
     limitedQueries.inc(stats.limited_queries());
     softDoomedQueries.inc(stats.softDoomed());
+    memoizationHits.inc(stats.memoizationHits());
+    memoizationMisses.inc(stats.memoizationMisses());
     softDoomFactor.set(stats.softDoomFactor());
     matchTime.addValueBatch(stats.matchTimeAvg(), stats.matchTimeCount(),
                             stats.matchTimeMin(), stats.matchTimeMax());
@@ -141,6 +141,8 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
             metrics::LongCountMetric     queries;
             metrics::LongCountMetric     limitedQueries;
             metrics::LongCountMetric     softDoomedQueries;
+            metrics::LongCountMetric     memoizationHits;
+            metrics::LongCountMetric     memoizationMisses;
             metrics::DoubleValueMetric   softDoomFactor;
             metrics::DoubleAverageMetric matchTime;
             metrics::DoubleAverageMetric groupingTime;
@@ -4,6 +4,7 @@
 
 using search::transactionlog::DomainInfo;
 using search::transactionlog::DomainStats;
+using search::transactionlog::GroupSyncStats;
 
 namespace proton {
 
@@ -27,6 +28,26 @@ TransLogServerMetrics::DomainMetrics::update(const DomainInfo &stats)
     replayTime.set(stats.maxSessionRunTime.count());
 }
 
+TransLogServerMetrics::GroupSyncMetrics::GroupSyncMetrics(metrics::MetricSet *parent)
+    : metrics::MetricSet("transactionlog.group_sync", {},
+            "Metrics for syncing of commits batched across all document types", parent),
+      syncs("syncs", {}, "Number of transaction log file syncs done by group sync", this),
+      batchSize("batch_size", {}, "Number of commits acked per group sync batch", this)
+{
+}
+
+TransLogServerMetrics::GroupSyncMetrics::~GroupSyncMetrics() = default;
+
+void
+TransLogServerMetrics::GroupSyncMetrics::update(const GroupSyncStats &stats)
+{
+    syncs.inc(stats.numSyncs);
+    const auto & bSize = stats.batchSize;
+    if (bSize.count() > 0) {
+        batchSize.addValueBatch(bSize.average(), bSize.count(), bSize.min(), bSize.max());
+    }
+}
+
 void
 TransLogServerMetrics::considerAddDomains(const DomainStats &stats)
 {
@@ -62,7 +83,8 @@ TransLogServerMetrics::updateDomainMetrics(const DomainStats &stats)
 }
 
 TransLogServerMetrics::TransLogServerMetrics(metrics::MetricSet *parent)
-    : _parent(parent)
+    : _parent(parent),
+      _groupSync(parent)
 {
 }
 
@@ -76,4 +98,10 @@ TransLogServerMetrics::update(const DomainStats &stats)
     updateDomainMetrics(stats);
 }
 
+void
+TransLogServerMetrics::update(const GroupSyncStats &stats)
+{
+    _groupSync.update(stats);
+}
+
 } // namespace proton
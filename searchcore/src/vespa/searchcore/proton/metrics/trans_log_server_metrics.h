@@ -3,8 +3,10 @@
 #pragma once
 
 #include <vespa/metrics/metricset.h>
+#include <vespa/metrics/countmetric.h>
 #include <vespa/metrics/valuemetric.h>
 #include <vespa/searchlib/transactionlog/domainconfig.h>
+#include <vespa/searchlib/transactionlog/group_syncer.h>
 
 namespace proton {
 
@@ -26,8 +28,19 @@ public:
         void update(const search::transactionlog::DomainInfo &stats);
     };
 
+    struct GroupSyncMetrics : public metrics::MetricSet
+    {
+        metrics::LongCountMetric   syncs;
+        metrics::LongAverageMetric batchSize;
+
+        explicit GroupSyncMetrics(metrics::MetricSet *parent);
+        ~GroupSyncMetrics() override;
+        void update(const search::transactionlog::GroupSyncStats &stats);
+    };
+
 private:
     metrics::MetricSet *_parent;
+    GroupSyncMetrics    _groupSync;
     std::map<std::string, DomainMetrics::UP> _domainMetrics;
 
     void considerAddDomains(const search::transactionlog::DomainStats &stats);
@@ -38,6 +51,7 @@ public:
     TransLogServerMetrics(metrics::MetricSet *parent);
     ~TransLogServerMetrics();
     void update(const search::transactionlog::DomainStats &stats);
+    void update(const search::transactionlog::GroupSyncStats &stats);
 };
 
 } // namespace proton
@@ -9,6 +9,12 @@ DocumentSubDbCollectionInitializer::DocumentSubDbCollectionInitializer()
 {
 }
 
+std::string
+DocumentSubDbCollectionInitializer::get_name() const
+{
+    return "subdbs";
+}
+
 void
 DocumentSubDbCollectionInitializer::run()
 {
@@ -23,6 +23,7 @@ public:
         addDependency(subDbInitializer);
     }
     virtual void run() override;
+    std::string get_name() const override;
 };
 
 } // namespace proton
@@ -26,6 +26,12 @@ addDocumentMetaStoreInitTask(InitTask::SP documentMetaStoreInitTask)
     addDependency(documentMetaStoreInitTask);
 }
 
+std::string
+DocumentSubDbInitializer::get_name() const
+{
+    return "subdb." + _subDB.getName();
+}
+
 void
 DocumentSubDbInitializer::run()
 {
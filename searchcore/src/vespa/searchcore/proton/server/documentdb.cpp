@@ -24,6 +24,7 @@
 #include <vespa/searchcore/proton/docsummary/isummarymanager.h>
 #include <vespa/searchcore/proton/feedoperation/noopoperation.h>
 #include <vespa/searchcore/proton/index/index_writer.h>
+#include <vespa/searchcore/proton/initializer/initializer_timeline.h>
 #include <vespa/searchcore/proton/initializer/task_runner.h>
 #include <vespa/searchcore/proton/metrics/executor_threading_service_stats.h>
 #include <vespa/searchcore/proton/metrics/metricswireservice.h>
@@ -37,6 +38,7 @@
 #include <vespa/searchlib/engine/searchreply.h>
 #include <vespa/vespalib/util/destructor_callbacks.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <algorithm>
 
 #include <vespa/log/log.h>
 #include <vespa/searchcorespi/index/warmupconfig.h>
@@ -62,6 +64,7 @@ using search::TuneFileDocumentDB;
 using storage::spi::Timestamp;
 using search::common::FileHeaderContext;
 using proton::initializer::InitializerTask;
+using proton::initializer::InitializerTimeline;
 using proton::initializer::TaskRunner;
 using vespalib::GateCallback;
 using vespalib::IDestructorCallback;
@@ -291,15 +294,18 @@ DocumentDB::internalInit()
 class InitDoneTask : public vespalib::Executor::Task {
     DocumentDB::InitializeThreads _initializeThreads;
     std::shared_ptr<TaskRunner>   _taskRunner;
+    InitializerTask::SP           _rootTask;
     DocumentDBConfig::SP          _configSnapshot;
     DocumentDB&                   _self;
 public:
     InitDoneTask(DocumentDB::InitializeThreads initializeThreads,
                  std::shared_ptr<TaskRunner> taskRunner,
+                 InitializerTask::SP rootTask,
                  DocumentDBConfig::SP configSnapshot,
                  DocumentDB& self)
         : _initializeThreads(std::move(initializeThreads)),
           _taskRunner(std::move(taskRunner)),
+          _rootTask(std::move(rootTask)),
           _configSnapshot(std::move(configSnapshot)),
           _self(self)
     {}
@@ -307,8 +313,29 @@ public:
     ~InitDoneTask() override;
 
     void run() override {
+        logInitTimeline();
+        _rootTask.reset();
         _self.initFinish(std::move(_configSnapshot));
     }
+private:
+    void logInitTimeline() const {
+        InitializerTimeline timeline(*_rootTask);
+        const auto &entries = timeline.entries();
+        auto slowest = std::max_element(entries.begin(), entries.end(),
+                                        [](const auto &lhs, const auto &rhs) { return lhs.duration < rhs.duration; });
+        if (slowest != entries.end()) {
+            LOG(info, "DocumentDB(%s): Initialized components in %.3f seconds, slowest was '%s' (%.3f seconds)",
+                _self.getName().c_str(), vespalib::to_s(timeline.elapsed()), slowest->name.c_str(),
+                vespalib::to_s(slowest->duration));
+        } else {
+            LOG(info, "DocumentDB(%s): Initialized components in %.3f seconds", _self.getName().c_str(),
+                vespalib::to_s(timeline.elapsed()));
+        }
+        for (const auto &entry : entries) {
+            LOG(debug, "DocumentDB(%s): Init timeline: '%s' started at %.3f, ran for %.3f seconds",
+                _self.getName().c_str(), entry.name.c_str(), vespalib::to_s(entry.start), vespalib::to_s(entry.duration));
+        }
+    }
 };
 
 InitDoneTask::~InitDoneTask() = default;
@@ -323,7 +350,7 @@ DocumentDB::initManagers()
     InitializeThreads initializeThreads = _initializeThreads;
     _initializeThreads.reset();
     std::shared_ptr<TaskRunner> taskRunner(std::make_shared<TaskRunner>(*initializeThreads));
-    auto doneTask = std::make_unique<InitDoneTask>(std::move(initializeThreads), taskRunner,
+    auto doneTask = std::make_unique<InitDoneTask>(std::move(initializeThreads), taskRunner, rootTask,
                                                    std::move(configSnapshot), *this);
     taskRunner->runTask(rootTask, _writeService.master(), std::move(doneTask));
 }
@@ -869,8 +896,8 @@ DocumentDB::reportStatus() const
                 message("DocumentDB initializing components"));
     } else if (_feedHandler->isDoingReplay()) {
         float progress = _feedHandler->getReplayProgress() * 100.0f;
-        std::string msg = vespalib::make_string("DocumentDB replay transaction log on startup (%u%% done)",
-                static_cast<uint32_t>(progress));
+        std::string msg = vespalib::make_string("DocumentDB replay transaction log on startup (%u%% done, %.0f entries/s)",
+                static_cast<uint32_t>(progress), _feedHandler->getReplayEntriesPerSecond());
         return StatusReport::create(params.state(StatusReport::PARTIAL).progress(progress).message(msg));
     } else if (rawState == DDBState::State::APPLY_LIVE_CONFIG) {
         return StatusReport::create(params.state(StatusReport::PARTIAL)
@@ -248,7 +248,8 @@ build_alloc_config(const vespalib::HwInfo & hwInfo, const ProtonConfig& proton_c
             : alloc_config.initialnumdocs;
     auto& distribution_config = proton_config.distribution;
     search::GrowStrategy grow_strategy(target_numdocs, alloc_config.growfactor, alloc_config.growbias, target_numdocs, alloc_config.multivaluegrowfactor);
-    CompactionStrategy compaction_strategy(alloc_config.maxDeadBytesRatio, alloc_config.maxDeadAddressSpaceRatio, alloc_config.maxCompactBuffers, alloc_config.activeBuffersRatio);
+    CompactionStrategy compaction_strategy(alloc_config.maxDeadBytesRatio, alloc_config.maxDeadAddressSpaceRatio, alloc_config.maxCompactBuffers, alloc_config.activeBuffersRatio,
+                                           alloc_config.compactionStepSize);
     return AllocConfig(AllocStrategy(grow_strategy, compaction_strategy, alloc_config.amortizecount),
                        distribution_config.redundancy, distribution_config.searchablecopies);
 }
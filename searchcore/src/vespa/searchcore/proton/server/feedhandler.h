@@ -232,6 +232,9 @@ public:
     float getReplayProgress() const {
         return _tlsReplayProgress ? _tlsReplayProgress->getProgress() : 0;
     }
+    double getReplayEntriesPerSecond() const {
+        return _tlsReplayProgress ? _tlsReplayProgress->getEntriesPerSecond() : 0;
+    }
     bool getTransactionLogReplayDone() const;
     std::string getDocTypeName() const { return _docTypeName.getName(); }
     void tlsPrune(SerialNum oldest_to_keep);
@@ -10,10 +10,13 @@
 #include <vespa/searchcore/proton/feedoperation/operations.h>
 #include <vespa/searchcore/proton/common/eventlogger.h>
 #include <vespa/searchcore/proton/common/replay_feed_token_factory.h>
+#include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/util/idestructorcallback.h>
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/shared_operation_throttler.h>
+#include <atomic>
 #include <cassert>
+#include <exception>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.server.feedstates");
@@ -45,7 +48,8 @@ handleProgress(TlsReplayProgress &progress, SerialNum currentSerial)
                                                   progress.getProgress(),
                                                   progress.getFirst(),
                                                   progress.getLast(),
-                                                  progress.getCurrent());
+                                                  progress.getCurrent(),
+                                                  progress.getEntriesPerSecond());
     }
 }
 
@@ -147,29 +151,152 @@ public:
     }
 };
 
+/**
+ * Decodes a range of packet entries into feed operations, spreading the
+ * work on the given executor. Chunks of entries are claimed from a shared
+ * counter, and the calling thread keeps claiming chunks until none are
+ * left. It only waits for chunks that a worker has already started, so
+ * replay never stalls on tasks still queued behind other work in the
+ * executor.
+ */
+class ParallelDecoder {
+public:
+    using Entries = std::vector<Packet::Entry>;
+    using Operations = std::vector<std::unique_ptr<FeedOperation>>;
+    static constexpr size_t ENTRIES_PER_TASK = 32;
+
+    ParallelDecoder(Executor &executor, const document::DocumentTypeRepo &repo) noexcept
+        : _executor(executor),
+          _repo(repo)
+    {}
+    Operations decode(const Entries &entries, size_t begin, size_t end) const;
+private:
+    /*
+     * Shared with the decode tasks. A task that runs after all chunks have
+     * been claimed only touches the chunk counter, and keeps it alive.
+     */
+    struct Work {
+        const Entries                    &entries;
+        const document::DocumentTypeRepo &repo;
+        Operations                       &ops;
+        size_t                            begin;
+        size_t                            end;
+        size_t                            num_chunks;
+        std::atomic<size_t>               next_chunk;
+        vespalib::CountDownLatch          latch;
+        std::vector<std::exception_ptr>   failures;
+        Work(const Entries &entries_in, const document::DocumentTypeRepo &repo_in, Operations &ops_in,
+             size_t begin_in, size_t end_in);
+        ~Work();
+    };
+    static void decode_chunks(Work &work);
+    Executor                          &_executor;
+    const document::DocumentTypeRepo  &_repo;
+};
+
+ParallelDecoder::Work::Work(const Entries &entries_in, const document::DocumentTypeRepo &repo_in, Operations &ops_in,
+                            size_t begin_in, size_t end_in)
+    : entries(entries_in),
+      repo(repo_in),
+      ops(ops_in),
+      begin(begin_in),
+      end(end_in),
+      num_chunks((end_in - begin_in + ENTRIES_PER_TASK - 1) / ENTRIES_PER_TASK),
+      next_chunk(0),
+      latch(num_chunks),
+      failures(num_chunks)
+{}
+
+ParallelDecoder::Work::~Work() = default;
+
+void
+ParallelDecoder::decode_chunks(Work &work)
+{
+    for (size_t chunk = work.next_chunk.fetch_add(1, std::memory_order_relaxed);
+         chunk < work.num_chunks;
+         chunk = work.next_chunk.fetch_add(1, std::memory_order_relaxed))
+    {
+        size_t chunk_begin = work.begin + chunk * ENTRIES_PER_TASK;
+        size_t chunk_end = std::min(work.end, chunk_begin + ENTRIES_PER_TASK);
+        try {
+            for (size_t i = chunk_begin; i < chunk_end; ++i) {
+                work.ops[i - work.begin] = ReplayPacketDispatcher::decode(work.entries[i], work.repo);
+            }
+        } catch (...) {
+            work.failures[chunk] = std::current_exception();
+        }
+        work.latch.countDown();
+    }
+}
+
+ParallelDecoder::Operations
+ParallelDecoder::decode(const Entries &entries, size_t begin, size_t end) const
+{
+    Operations ops(end - begin);
+    auto work = std::make_shared<Work>(entries, _repo, ops, begin, end);
+    for (size_t task = 1; task < work->num_chunks; ++task) {
+        auto rejected = _executor.execute(makeLambdaTask([work]() { decode_chunks(*work); }));
+        if (rejected) {
+            break;
+        }
+    }
+    decode_chunks(*work);
+    work->latch.await();
+    for (const auto &failure : work->failures) {
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+    }
+    return ops;
+}
+
 class PacketDispatcher {
 public:
-    PacketDispatcher(IReplayPacketHandler *packet_handler)
-        : _packet_handler(packet_handler)
+    PacketDispatcher(IReplayPacketHandler *packet_handler, Executor &decode_executor)
+        : _packet_handler(packet_handler),
+          _decode_executor(decode_executor)
     {}
 
     void handlePacket(PacketWrapper & wrap);
 private:
     void handleEntry(const Packet::Entry &entry);
+    void handleDecoded(const FeedOperation &op);
     IReplayPacketHandler *_packet_handler;
+    Executor             &_decode_executor;
 };
 
 void
 PacketDispatcher::handlePacket(PacketWrapper & wrap)
 {
+    std::vector<Packet::Entry> entries;
+    entries.reserve(wrap.packet.size());
     vespalib::nbostream_longlivedbuf handle(wrap.packet.getHandle().data(), wrap.packet.getHandle().size());
     while ( !handle.empty() ) {
-        Packet::Entry entry;
-        entry.deserialize(handle);
-        handleEntry(entry);
-        if (wrap.progress != nullptr) {
-            handleProgress(*wrap.progress, entry.serial());
+        entries.emplace_back().deserialize(handle);
+    }
+    for (size_t i = 0; i < entries.size(); ) {
+        if ( ! ReplayPacketDispatcher::canDecodeAhead(entries[i])) {
+            // Replaying a new config might change the document type repo used for decoding.
+            handleEntry(entries[i]);
+            if (wrap.progress != nullptr) {
+                handleProgress(*wrap.progress, entries[i].serial());
+            }
+            ++i;
+            continue;
         }
+        size_t end = i + 1;
+        while ((end < entries.size()) && ReplayPacketDispatcher::canDecodeAhead(entries[end])) {
+            ++end;
+        }
+        ParallelDecoder decoder(_decode_executor, _packet_handler->getDeserializeRepo());
+        auto ops = decoder.decode(entries, i, end);
+        for (const auto &op : ops) {
+            handleDecoded(*op);
+            if (wrap.progress != nullptr) {
+                handleProgress(*wrap.progress, op->getSerialNum());
+            }
+        }
+        i = end;
     }
     wrap.result = RPC::OK;
     wrap.gate.countDown();
@@ -187,6 +314,18 @@ PacketDispatcher::handleEntry(const Packet::Entry &entry) {
     _packet_handler->optionalCommit(entry_serial_num);
 }
 
+void
+PacketDispatcher::handleDecoded(const FeedOperation &op) {
+    // Called by handlePacket() in executor thread, operations are dispatched in serial number order.
+    LOG(spam, "replay decoded operation: serial(%" PRIu64 "), type(%u)", op.getSerialNum(), op.getType());
+
+    auto serial_num = op.getSerialNum();
+    _packet_handler->check_serial_num(serial_num);
+    ReplayPacketDispatcher dispatcher(*_packet_handler);
+    dispatcher.replayDecoded(op);
+    _packet_handler->optionalCommit(serial_num);
+}
+
 }  // namespace
 
 ReplayTransactionLogState::ReplayTransactionLogState(
@@ -196,9 +335,11 @@ ReplayTransactionLogState::ReplayTransactionLogState(
         IReplayConfig &replay_config,
         FeedConfigStore &config_store,
         const ReplayThrottlingPolicy &replay_throttling_policy,
-        IIncSerialNum& inc_serial_num)
+        IIncSerialNum& inc_serial_num,
+        Executor &decode_executor)
     : FeedState(REPLAY_TRANSACTION_LOG),
       _doc_type_name(name),
+      _decode_executor(decode_executor),
       _packet_handler(std::make_unique<TransactionLogReplayPacketHandler>(feed_view_ptr, bucketDBHandler, replay_config, config_store, replay_throttling_policy, inc_serial_num))
 { }
 
@@ -207,7 +348,7 @@ ReplayTransactionLogState::~ReplayTransactionLogState() = default;
 void
 ReplayTransactionLogState::receive(const PacketWrapper::SP &wrap, Executor &executor) {
     executor.execute(makeLambdaTask([this, wrap = wrap] () {
-        PacketDispatcher dispatcher(_packet_handler.get());
+        PacketDispatcher dispatcher(_packet_handler.get(), _decode_executor);
         dispatcher.handlePacket(*wrap);
     }));
 }
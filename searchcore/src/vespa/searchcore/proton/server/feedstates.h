@@ -47,6 +47,7 @@ public:
  */
 class ReplayTransactionLogState : public FeedState {
     std::string _doc_type_name;
+    vespalib::Executor &_decode_executor;
     std::unique_ptr<IReplayPacketHandler> _packet_handler;
 
 public:
@@ -56,7 +57,8 @@ public:
             IReplayConfig &replay_config,
             FeedConfigStore &config_store,
             const ReplayThrottlingPolicy &replay_throttling_policy,
-            IIncSerialNum &inc_serial_num);
+            IIncSerialNum &inc_serial_num,
+            vespalib::Executor &decode_executor);
 
     ~ReplayTransactionLogState() override;
     void handleOperation(FeedToken, FeedOperationUP op) override {
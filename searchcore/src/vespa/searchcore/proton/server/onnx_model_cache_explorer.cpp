@@ -0,0 +1,34 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "onnx_model_cache_explorer.h"
+#include <vespa/eval/onnx/onnx_model_cache.h>
+#include <vespa/vespalib/data/slime/cursor.h>
+
+using vespalib::eval::OnnxModelCache;
+
+namespace proton {
+
+void
+OnnxModelCacheExplorer::get_state(const vespalib::slime::Inserter& inserter, bool full) const
+{
+    auto& object = inserter.insertObject();
+    auto models = OnnxModelCache::list_models();
+    size_t total_file_size = 0;
+    for (const auto& model : models) {
+        total_file_size += model.file_size;
+    }
+    object.setLong("num_models", models.size());
+    object.setLong("file_size_bytes", total_file_size);
+    if (full) {
+        auto& array = object.setArray("models");
+        for (const auto& model : models) {
+            auto& entry = array.addObject();
+            entry.setString("file", model.file);
+            entry.setLong("file_size_bytes", model.file_size);
+            entry.setLong("num_refs", model.num_refs);
+            entry.setBool("mapped_weights", model.mapped_weights);
+        }
+    }
+}
+
+}
@@ -0,0 +1,19 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/net/http/state_explorer.h>
+
+namespace proton {
+
+/**
+ * Class used to explore the onnx models shared between all rank
+ * profiles and document types in proton (see vespalib::eval::OnnxModelCache).
+ */
+class OnnxModelCacheExplorer : public vespalib::StateExplorer
+{
+public:
+    void get_state(const vespalib::slime::Inserter& inserter, bool full) const override;
+};
+
+}
@@ -9,6 +9,7 @@
 #include "hw_info_explorer.h"
 #include "initialize_threads_calculator.h"
 #include "memoryflush.h"
+#include "onnx_model_cache_explorer.h"
 #include "persistencehandlerproxy.h"
 #include "prepare_restart_handler.h"
 #include "proton_config_snapshot.h"
@@ -800,6 +801,7 @@ Proton::updateMetrics(const metrics::MetricLockGuard &)
         auto tls = _tls->getTransLogServer();
         if (tls) {
             metrics.transactionLog.update(tls->getDomainStats());
+            metrics.transactionLog.update(tls->getGroupSyncStats());
         }
 
         const DiskMemUsageFilter &usageFilter = _diskMemUsageSampler->writeFilter();
@@ -943,6 +945,7 @@ const std::string TLS_NAME = "tls";
 const std::string RESOURCE_USAGE = "resourceusage";
 const std::string THREAD_POOLS = "threadpools";
 const std::string HW_INFO = "hwinfo";
+const std::string ONNX_MODELS = "onnxmodels";
 const std::string SESSION = "session";
 
 
@@ -989,7 +992,7 @@ Proton::get_state(const vespalib::slime::Inserter &, bool) const
 std::vector<std::string>
 Proton::get_children_names() const
 {
-    return {DOCUMENT_DB, THREAD_POOLS, MATCH_ENGINE, FLUSH_ENGINE, TLS_NAME, HW_INFO, RESOURCE_USAGE, SESSION};
+    return {DOCUMENT_DB, THREAD_POOLS, MATCH_ENGINE, FLUSH_ENGINE, TLS_NAME, HW_INFO, ONNX_MODELS, RESOURCE_USAGE, SESSION};
 }
 
 std::unique_ptr<vespalib::StateExplorer>
@@ -1016,6 +1019,8 @@ Proton::get_child(std::string_view name) const
 
     } else if (name == HW_INFO) {
         return std::make_unique<HwInfoExplorer>(_hw_info);
+    } else if (name == ONNX_MODELS) {
+        return std::make_unique<OnnxModelCacheExplorer>();
     } else if (name == SESSION) {
         return std::make_unique<matching::SessionManagerExplorer>(*_sessionManager);
     }
@@ -12,6 +12,11 @@ class FeedOperation;
  * Utility class that deserializes packet entries into feed operations
  * during replay from the transaction log and dispatches the feed operations
  * to a given handler class.
+ *
+ * Deserializing (decode) and dispatching (replayDecoded) can also be done as
+ * separate steps, allowing entries to be decoded ahead of time in other threads.
+ * Entries with a new config cannot be decoded ahead, since they change the
+ * document type repo used for decoding the entries following them.
  */
 class ReplayPacketDispatcher
 {
@@ -19,9 +24,6 @@ private:
     using Packet = search::transactionlog::Packet;
     IReplayPacketHandler &_handler;
 
-    template <typename OperationType>
-    void replay(OperationType &op, vespalib::nbostream &is, const Packet::Entry &entry);
-
 protected:
     virtual void store(const FeedOperation &op);
 
@@ -30,6 +32,10 @@ public:
     virtual ~ReplayPacketDispatcher();
 
     void replayEntry(const Packet::Entry &entry);
+
+    static bool canDecodeAhead(const Packet::Entry &entry) noexcept;
+    static std::unique_ptr<FeedOperation> decode(const Packet::Entry &entry, const document::DocumentTypeRepo &repo);
+    void replayDecoded(const FeedOperation &op);
 };
 
 } // namespace proton
@@ -18,14 +18,14 @@
 #include <vespa/searchcore/proton/reprocessing/i_reprocessing_initializer.h>
 #include <vespa/searchlib/fef/indexproperties.h>
 #include <vespa/searchlib/fef/properties.h>
-#include <vespa/eval/eval/fast_value.h>
+#include <vespa/eval/eval/value_cache/constant_value_cache.h>
 
 using vespa::config::search::RankProfilesConfig;
 using proton::matching::MatchingStats;
 using search::GrowStrategy;
 using search::index::Schema;
 using search::SerialNum;
-using vespalib::eval::FastValueBuilderFactory;
+using vespalib::eval::ConstantValueCache;
 using namespace searchcorespi;
 
 namespace proton {
@@ -37,9 +37,7 @@ SearchableDocSubDB::SearchableDocSubDB(const Config &cfg, const Context &ctx)
       _indexWriter(),
       _rSearchView(),
       _rFeedView(),
-      _tensorLoader(FastValueBuilderFactory::get()),
-      _constantValueCache(_tensorLoader),
-      _configurer(_iSummaryMgr, _rSearchView, _rFeedView, ctx._queryLimiter, _constantValueCache, ctx._now_ref,
+      _configurer(_iSummaryMgr, _rSearchView, _rFeedView, ctx._queryLimiter, ConstantValueCache::shared_tensor_cache(), ctx._now_ref,
                   getSubDbName(), ctx._fastUpdCtx._storeOnlyCtx._owner.getDistributionKey()),
       _warmupExecutor(ctx._warmupExecutor),
       _realGidToLidChangeHandler(std::make_shared<GidToLidChangeHandler>()),
@@ -0,0 +1,205 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+package com.yahoo.searchlib.aggregation;
+
+import com.yahoo.vespa.objects.Deserializer;
+import com.yahoo.vespa.objects.Serializer;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Comparator;
+import java.util.List;
+
+/**
+ * KLL quantile sketch (Karnin, Lang, Liberty) for doubles, matching search::KllSketch in C++. Values are kept in a
+ * hierarchy of compactors where an item at level h represents 2^h inputs. When the sketch exceeds its capacity, the
+ * lowest full compactor is sorted and every other item is promoted to the next level. Compactions are done exactly
+ * as in C++, so merging gives the same sketch on both sides.
+ */
+public class KllSketch {
+
+    public static final int DEFAULT_K = 200;
+    private static final int MIN_K = 8;
+    private static final double CAPACITY_DECAY = 2.0 / 3.0;
+
+    private int k;
+    private long count = 0;
+    private int size = 0;
+    private int capacity;
+    private int compactions = 0;
+    private List<List<Double>> levels = new ArrayList<>();
+
+    public KllSketch() {
+        this(DEFAULT_K);
+    }
+
+    public KllSketch(int k) {
+        this.k = Math.max(k, MIN_K);
+        levels.add(new ArrayList<>());
+        capacity = calcCapacity();
+    }
+
+    /** Returns a deep copy of this sketch. */
+    public KllSketch copy() {
+        KllSketch copy = new KllSketch(k);
+        copy.count = count;
+        copy.size = size;
+        copy.compactions = compactions;
+        copy.levels = new ArrayList<>();
+        for (List<Double> level : levels) {
+            copy.levels.add(new ArrayList<>(level));
+        }
+        copy.capacity = copy.calcCapacity();
+        return copy;
+    }
+
+    public int getK() { return k; }
+
+    public long getCount() { return count; }
+
+    /** Returns the number of values retained by the sketch. */
+    public int getSize() { return size; }
+
+    public void aggregate(double value) {
+        if (Double.isNaN(value)) {
+            return;
+        }
+        levels.get(0).add(value);
+        ++count;
+        ++size;
+        if (size > capacity) {
+            compress();
+        }
+    }
+
+    public void merge(KllSketch other) {
+        while (levels.size() < other.levels.size()) {
+            levels.add(new ArrayList<>());
+        }
+        for (int level = 0; level < other.levels.size(); ++level) {
+            levels.get(level).addAll(other.levels.get(level));
+        }
+        count += other.count;
+        size += other.size;
+        capacity = calcCapacity();
+        compress();
+    }
+
+    /** Returns the estimated value at the given quantile in [0, 1], or NaN if the sketch is empty. */
+    public double quantile(double q) {
+        List<double[]> weighted = new ArrayList<>(size);
+        long total = 0;
+        for (int level = 0; level < levels.size(); ++level) {
+            long weight = 1L << level;
+            for (double value : levels.get(level)) {
+                weighted.add(new double[] { value, weight });
+                total += weight;
+            }
+        }
+        if (weighted.isEmpty()) {
+            return Double.NaN;
+        }
+        weighted.sort(Comparator.<double[]>comparingDouble(entry -> entry[0]).thenComparingDouble(entry -> entry[1]));
+        double wanted = Math.min(Math.max(q, 0.0), 1.0) * total;
+        long seen = 0;
+        for (double[] entry : weighted) {
+            seen += (long)entry[1];
+            if (seen >= wanted) {
+                return entry[0];
+            }
+        }
+        return weighted.get(weighted.size() - 1)[0];
+    }
+
+    public void serialize(Serializer buf) {
+        buf.putInt(null, k);
+        buf.putLong(null, count);
+        buf.putInt(null, levels.size());
+        for (List<Double> level : levels) {
+            buf.putInt(null, level.size());
+            for (double value : level) {
+                buf.putDouble(null, value);
+            }
+        }
+    }
+
+    public void deserialize(Deserializer buf) {
+        k = buf.getInt(null);
+        count = buf.getLong(null);
+        int numLevels = buf.getInt(null);
+        levels = new ArrayList<>();
+        size = 0;
+        for (int i = 0; i < numLevels; ++i) {
+            int levelSize = buf.getInt(null);
+            List<Double> level = new ArrayList<>(levelSize);
+            for (int j = 0; j < levelSize; ++j) {
+                level.add(buf.getDouble(null));
+            }
+            levels.add(level);
+            size += levelSize;
+        }
+        if (levels.isEmpty()) {
+            levels.add(new ArrayList<>());
+        }
+        capacity = calcCapacity();
+    }
+
+    private int levelCapacity(int level) {
+        int depth = levels.size() - 1 - level;
+        return Math.max(2, (int)Math.ceil(k * Math.pow(CAPACITY_DECAY, depth)));
+    }
+
+    private int calcCapacity() {
+        int result = 0;
+        for (int level = 0; level < levels.size(); ++level) {
+            result += levelCapacity(level);
+        }
+        return result;
+    }
+
+    private void compact(int level) {
+        if (level + 1 == levels.size()) {
+            levels.add(new ArrayList<>());
+            capacity = calcCapacity();
+        }
+        List<Double> items = levels.get(level);
+        items.sort(null);
+        // An odd item out stays at this level to keep the total weight exact.
+        int keep = items.size() % 2;
+        int offset = (compactions++) % 2;
+        List<Double> next = levels.get(level + 1);
+        for (int i = keep + offset; i < items.size(); i += 2) {
+            next.add(items.get(i));
+        }
+        size -= (items.size() - keep) / 2;
+        items.subList(keep, items.size()).clear();
+    }
+
+    private void compress() {
+        while (size > capacity) {
+            for (int level = 0; level < levels.size(); ++level) {
+                if (levels.get(level).size() >= levelCapacity(level)) {
+                    compact(level);
+                    break;
+                }
+            }
+        }
+    }
+
+    @Override
+    public boolean equals(Object obj) {
+        if (this == obj) return true;
+        if (!(obj instanceof KllSketch other)) return false;
+        return k == other.k && count == other.count && levels.equals(other.levels);
+    }
+
+    @Override
+    public int hashCode() {
+        return Arrays.hashCode(new Object[] { k, count, levels });
+    }
+
+    @Override
+    public String toString() {
+        return "KllSketch{k=" + k + ", count=" + count + ", levels=" + levels + "}";
+    }
+
+}
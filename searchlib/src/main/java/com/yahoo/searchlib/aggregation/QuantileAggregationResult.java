@@ -0,0 +1,125 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+package com.yahoo.searchlib.aggregation;
+
+import com.yahoo.searchlib.expression.FloatResultNode;
+import com.yahoo.searchlib.expression.FloatResultNodeVector;
+import com.yahoo.searchlib.expression.ResultNode;
+import com.yahoo.vespa.objects.Deserializer;
+import com.yahoo.vespa.objects.ObjectVisitor;
+import com.yahoo.vespa.objects.Serializer;
+
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * This is an aggregated result estimating quantiles (e.g. p50 and p99) of the values that the contained expression
+ * evaluated to. The values are kept in a mergeable {@link KllSketch} populated by the search nodes, so partial results
+ * are merged without transferring the raw values. The rank is the vector of the estimated values for the requested
+ * quantiles.
+ */
+public class QuantileAggregationResult extends AggregationResult {
+
+    public static final int classId = registerClass(0x4000 + 98, QuantileAggregationResult.class, QuantileAggregationResult::new);
+
+    private List<Double> quantiles;
+    private KllSketch sketch;
+
+    /** Constructor used for deserialization. Will be instantiated with an empty sketch. */
+    public QuantileAggregationResult() {
+        this(List.of(), new KllSketch());
+    }
+
+    public QuantileAggregationResult(List<Double> quantiles) {
+        this(quantiles, new KllSketch());
+    }
+
+    public QuantileAggregationResult(List<Double> quantiles, KllSketch sketch) {
+        this.quantiles = List.copyOf(quantiles);
+        this.sketch = sketch;
+    }
+
+    /** Returns the quantiles, in [0, 1], to estimate. */
+    public List<Double> getQuantiles() {
+        return quantiles;
+    }
+
+    public KllSketch getSketch() {
+        return sketch;
+    }
+
+    /** Returns the estimated value at the given quantile, or NaN if no values were aggregated. */
+    public double getQuantile(double q) {
+        return sketch.quantile(q);
+    }
+
+    @Override
+    public ResultNode getRank() {
+        FloatResultNodeVector rank = new FloatResultNodeVector();
+        for (double q : quantiles) {
+            rank.add(new FloatResultNode(sketch.quantile(q)));
+        }
+        return rank;
+    }
+
+    @Override
+    protected void onMerge(AggregationResult result) {
+        sketch.merge(((QuantileAggregationResult)result).sketch);
+    }
+
+    @Override
+    protected int onGetClassId() {
+        return classId;
+    }
+
+    @Override
+    protected void onSerialize(Serializer buf) {
+        super.onSerialize(buf);
+        buf.putInt(null, quantiles.size());
+        for (double q : quantiles) {
+            buf.putDouble(null, q);
+        }
+        sketch.serialize(buf);
+    }
+
+    @Override
+    protected void onDeserialize(Deserializer buf) {
+        super.onDeserialize(buf);
+        int numQuantiles = buf.getInt(null);
+        List<Double> result = new ArrayList<>(numQuantiles);
+        for (int i = 0; i < numQuantiles; ++i) {
+            result.add(buf.getDouble(null));
+        }
+        quantiles = List.copyOf(result);
+        sketch = new KllSketch();
+        sketch.deserialize(buf);
+    }
+
+    @Override
+    public QuantileAggregationResult clone() {
+        QuantileAggregationResult obj = (QuantileAggregationResult)super.clone();
+        obj.sketch = sketch.copy();
+        return obj;
+    }
+
+    @Override
+    protected boolean equalsAggregation(AggregationResult obj) {
+        QuantileAggregationResult rhs = (QuantileAggregationResult)obj;
+        return quantiles.equals(rhs.quantiles) && sketch.equals(rhs.sketch);
+    }
+
+    @Override
+    public int hashCode() {
+        int result = super.hashCode();
+        result = 31 * result + quantiles.hashCode();
+        result = 31 * result + sketch.hashCode();
+        return result;
+    }
+
+    @Override
+    public void visitMembers(ObjectVisitor visitor) {
+        super.visitMembers(visitor);
+        visitor.visit("quantiles", quantiles);
+        visitor.visit("count", sketch.getCount());
+    }
+
+}
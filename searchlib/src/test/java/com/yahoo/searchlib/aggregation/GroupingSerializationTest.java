@@ -56,6 +56,7 @@ import java.nio.ByteBuffer;
 import java.nio.ByteOrder;
 import java.nio.charset.StandardCharsets;
 import java.util.Arrays;
+import java.util.List;
 
 import static org.junit.Assert.fail;
 
@@ -197,6 +198,10 @@ public class GroupingSerializationTest {
                     .setExpression(new ConstantNode(new IntegerResultNode(67))));
             t.assertMatch(new StandardDeviationAggregationResult(1, 67, 67 * 67)
                     .setExpression(new ConstantNode(new IntegerResultNode(67))));
+            KllSketch sketch = new KllSketch();
+            sketch.aggregate(67);
+            t.assertMatch(new QuantileAggregationResult(List.of(0.5, 0.99), sketch)
+                    .setExpression(new ConstantNode(new IntegerResultNode(67))));
         }
     }
 
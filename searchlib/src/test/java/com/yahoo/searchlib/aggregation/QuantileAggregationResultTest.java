@@ -0,0 +1,45 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+package com.yahoo.searchlib.aggregation;
+
+import com.yahoo.searchlib.expression.FloatResultNodeVector;
+import org.junit.Test;
+
+import java.util.List;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+public class QuantileAggregationResultTest {
+
+    private static KllSketch sketchOf(int from, int to) {
+        KllSketch sketch = new KllSketch();
+        for (int i = from; i < to; ++i) {
+            sketch.aggregate(i);
+        }
+        return sketch;
+    }
+
+    @Test
+    public void rank_is_estimated_quantiles() {
+        QuantileAggregationResult result = new QuantileAggregationResult(List.of(0.5, 0.99), sketchOf(0, 10000));
+        FloatResultNodeVector rank = (FloatResultNodeVector)result.getRank();
+        assertEquals(2, rank.size());
+        assertEquals(5000, rank.getVector().get(0).getFloat(), 100);
+        assertEquals(9900, rank.getVector().get(1).getFloat(), 100);
+    }
+
+    @Test
+    public void merged_sketches_are_bounded_and_keep_all_weight() {
+        QuantileAggregationResult result = new QuantileAggregationResult(List.of(0.5), sketchOf(0, 5000));
+        result.merge(new QuantileAggregationResult(List.of(0.5), sketchOf(5000, 10000)));
+        assertEquals(10000, result.getSketch().getCount());
+        assertTrue(result.getSketch().getSize() < 1000);
+        assertEquals(5000, result.getQuantile(0.5), 100);
+    }
+
+    @Test
+    public void empty_sketch_gives_nan() {
+        assertTrue(Double.isNaN(new QuantileAggregationResult(List.of(0.5)).getQuantile(0.5)));
+    }
+
+}
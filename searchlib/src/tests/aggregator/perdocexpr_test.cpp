@@ -259,6 +259,52 @@ TEST("require that StandardDeviationAggregationResult aggregates multi-value exp
     EXPECT_APPROX(41.5, aggr.getRank().getFloat(), 0.1);
 }
 
+TEST("require that QuantileAggregationResult rank is the estimated quantiles of aggregated values") {
+    QuantileAggregationResult aggr;
+    aggr.setQuantiles({0.0, 0.5, 1.0});
+    aggr.setExpression(createVectorFloat(std::vector<double>({30.5, 10.25, 20.0, 50.0, 40.0})))
+        .aggregate(DocId(42), HitRank(21));
+    EXPECT_EQUAL(5u, aggr.getSketch().getCount());
+    const auto & rank = static_cast<const FloatResultNodeVector &>(aggr.getRank());
+    ASSERT_EQUAL(3u, rank.size());
+    EXPECT_EQUAL(10.25, rank.get(0).getFloat());
+    EXPECT_EQUAL(30.5, rank.get(1).getFloat());
+    EXPECT_EQUAL(50.0, rank.get(2).getFloat());
+}
+
+TEST("require that QuantileAggregationResult can be merged") {
+    QuantileAggregationResult aggr1;
+    aggr1.setExpression(MU<ConstantNode>(MU<Int64ResultNode>(8))).
+            aggregate(DocId(42), HitRank(21));
+
+    QuantileAggregationResult aggr2;
+    aggr2.setExpression(MU<ConstantNode>(MU<Int64ResultNode>(10))).
+            aggregate(DocId(43), HitRank(8));
+
+    aggr1.merge(aggr2);
+    EXPECT_EQUAL(2u, aggr1.getSketch().getCount());
+    EXPECT_EQUAL(8.0, aggr1.quantile(0.0));
+    EXPECT_EQUAL(10.0, aggr1.quantile(1.0));
+}
+
+TEST("require that QuantileAggregationResult can be serialized") {
+    QuantileAggregationResult aggr1;
+    aggr1.setQuantiles({0.5, 0.99});
+    aggr1.setExpression(createVectorFloat(std::vector<double>({1.5, 100.25, 30.125}))).
+            aggregate(DocId(42), HitRank(21));
+
+    nbostream os;
+    NBOSerializer nos(os);
+    nos << aggr1;
+    Identifiable::UP obj = Identifiable::create(nos);
+    auto *aggr2 = dynamic_cast<QuantileAggregationResult *>(obj.get());
+    ASSERT_TRUE(aggr2);
+    EXPECT_TRUE(os.empty());
+    EXPECT_TRUE(aggr1.getQuantiles() == aggr2->getQuantiles());
+    EXPECT_TRUE(aggr1.getSketch() == aggr2->getSketch());
+    EXPECT_EQUAL(0, aggr1.getRank().cmp(aggr2->getRank()));
+}
+
 void testAdd(const ResultNode &a, const ResultNode &b, const ResultNode &c) {
     AddFunctionNode func;
     func.appendArg(MU<ConstantNode>(ResultNode::UP(a.clone())))
@@ -1703,6 +1749,7 @@ TEST("testStreamingAll") {
     testStreaming(CountAggregationResult());
     testStreaming(ExpressionCountAggregationResult());
     testStreaming(StandardDeviationAggregationResult());
+    testStreaming(QuantileAggregationResult());
     testStreaming(SumAggregationResult());
     testStreaming(MinAggregationResult());
     testStreaming(MaxAggregationResult());
@@ -151,9 +151,8 @@ public:
         return buffers.size();
     }
 
-    void compactWorst() {
+    void compactWorst(const CompactionStrategy& compaction_strategy = CompactionStrategy()) {
         CompactionSpec compaction_spec(true, false);
-        CompactionStrategy compaction_strategy;
         _mvMapping->set_compaction_spec(compaction_spec);
         _mvMapping->compact_worst(compaction_strategy);
         _attr->commit();
@@ -373,4 +372,26 @@ TEST_F(CompactionIntMappingTest, test_that_compaction_works)
     EXPECT_LT(bufferCountAfter, bufferCountBefore);
 }
 
+TEST_F(CompactionIntMappingTest, test_that_compaction_can_be_done_in_steps)
+{
+    setup(3, 64, 512, 129);
+    addRandomDocs(2000);
+    for (uint32_t docId = 0; docId < 1000; ++docId) {
+        clearDoc(docId);
+    }
+    CompactionStrategy compaction_strategy(0.05, 0.2, 1, 0.1, 300);
+    compactWorst(compaction_strategy);
+    uint32_t steps = 1;
+    while (_mvMapping->is_compacting()) {
+        // Feed continues between the compaction steps.
+        addRandomDocs(10);
+        clearDoc(1000 + steps);
+        checkRefMapping();
+        compactWorst(compaction_strategy);
+        ++steps;
+    }
+    EXPECT_LT(1u, steps);
+    checkRefMapping();
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
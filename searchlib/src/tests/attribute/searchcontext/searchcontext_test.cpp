@@ -1913,6 +1913,97 @@ TEST_F(SearchContextTest, single_bool_attribute_search_iterator_handles_true_and
     EXPECT_EQ(false_exp, f.search_iterator("0", true));
 }
 
+TEST_F(SearchContextTest, single_numeric_range_search_scans_value_array_in_blocks)
+{
+    // Spans several 64 document blocks, with hits at both ends of each block.
+    constexpr uint32_t num_docs = 300;
+    std::vector<int32_t> values(num_docs - 1);
+    SimpleResult exp;
+    for (uint32_t docid = 1; docid < num_docs; ++docid) {
+        values[docid - 1] = ((docid % 64 == 0) || (docid % 64 == 63) || (docid % 5 == 0)) ? 10 : 100;
+        if (values[docid - 1] == 10) {
+            exp.addHit(docid);
+        }
+    }
+    auto attr = AttributeBuilder("int32", Config(BasicType::INT32)).fill(values).get();
+    auto sc = attr->getSearch(std::make_unique<search::QueryTermSimple>("[5;15]", TermType::WORD), SearchContextParams());
+    for (bool strict : {true, false}) {
+        TermFieldMatchData tfmd;
+        auto itr = sc->createIterator(&tfmd, strict);
+        SimpleResult result;
+        if (strict) {
+            result.searchStrict(*itr, num_docs);
+        } else {
+            result.search(*itr, num_docs);
+        }
+        EXPECT_EQ(exp, result);
+    }
+    TermFieldMatchData tfmd;
+    auto itr = sc->createIterator(&tfmd, true);
+    itr->initRange(1, num_docs);
+    auto hits = itr->get_hits(1);
+    EXPECT_EQ(exp.getHitCount(), hits->countTrueBits());
+    auto or_result = BitVector::create(1, num_docs);
+    or_result->setBit(2);
+    itr->initRange(1, num_docs);
+    itr->or_hits_into(*or_result, 1);
+    EXPECT_EQ(exp.getHitCount() + 1, or_result->countTrueBits());
+    for (uint32_t i = 0; i < exp.getHitCount(); ++i) {
+        EXPECT_TRUE(hits->testBit(exp.getHit(i)));
+        EXPECT_TRUE(or_result->testBit(exp.getHit(i)));
+    }
+}
+
+TEST_F(SearchContextTest, strict_single_numeric_range_search_takes_seeks_from_scanned_block)
+{
+    constexpr uint32_t num_docs = 300;
+    std::vector<int32_t> values(num_docs - 1);
+    std::vector<uint32_t> exp;
+    for (uint32_t docid = 1; docid < num_docs; ++docid) {
+        values[docid - 1] = ((docid % 7 == 0) || (docid > 250)) ? 10 : 100;
+        if (values[docid - 1] == 10) {
+            exp.push_back(docid);
+        }
+    }
+    auto seek_all = [](SearchIterator& itr, uint32_t begin, uint32_t end) {
+        std::vector<uint32_t> hits;
+        itr.initRange(begin, end);
+        for (uint32_t docid = itr.seekFirst(begin); !itr.isAtEnd(); docid = itr.seekNext(docid + 1)) {
+            hits.push_back(docid);
+        }
+        return hits;
+    };
+    auto expected = [&exp](uint32_t begin, uint32_t end) {
+        std::vector<uint32_t> hits;
+        std::copy_if(exp.begin(), exp.end(), std::back_inserter(hits), [=](uint32_t docid) { return docid >= begin && docid < end; });
+        return hits;
+    };
+    for (bool filter : {false, true}) {
+        SCOPED_TRACE(filter ? "filter" : "normal");
+        auto attr = AttributeBuilder("int32", Config(BasicType::INT32).setIsFilter(filter)).fill(values).get();
+        auto sc = attr->getSearch(std::make_unique<search::QueryTermSimple>("[5;15]", TermType::WORD), SearchContextParams());
+        TermFieldMatchData tfmd;
+        auto itr = sc->createIterator(&tfmd, true);
+        // A block scanned for a smaller range must not hide hits when the range is extended.
+        EXPECT_EQ(expected(1, 100), seek_all(*itr, 1, 100));
+        EXPECT_EQ(expected(90, num_docs), seek_all(*itr, 90, num_docs));
+        EXPECT_EQ(expected(1, num_docs), seek_all(*itr, 1, num_docs));
+        itr->initRange(1, num_docs);
+        EXPECT_TRUE(itr->seek(14));
+        itr->unpack(14);
+        EXPECT_EQ(14u, tfmd.getDocId());
+        if (!filter) {
+            EXPECT_EQ(1, tfmd.getWeight());
+        }
+        EXPECT_FALSE(itr->seek(15));
+        EXPECT_EQ(21u, itr->getDocId());
+        EXPECT_TRUE(itr->seek(251));
+        EXPECT_TRUE(itr->seek(299));
+        EXPECT_FALSE(itr->seek(300));
+        EXPECT_TRUE(itr->isAtEnd());
+    }
+}
+
 void
 SearchContextTest::initIntegerConfig()
 {
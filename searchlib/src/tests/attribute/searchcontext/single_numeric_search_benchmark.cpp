@@ -0,0 +1,96 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcommon/attribute/config.h>
+#include <vespa/searchlib/attribute/attributevector.h>
+#include <vespa/searchlib/attribute/search_context.h>
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/searchlib/test/attribute_builder.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <random>
+
+using search::AttributeVector;
+using search::QueryTermSimple;
+using search::attribute::BasicType;
+using search::attribute::Config;
+using search::attribute::SearchContextParams;
+using search::attribute::test::AttributeBuilder;
+using search::fef::TermFieldMatchData;
+using search::queryeval::SearchIterator;
+
+namespace {
+
+constexpr uint32_t num_docs = 4000000;
+
+/*
+ * Values are uniformly distributed in [0, 1000), so the range [0;n-1] matches
+ * about n per mille of the documents.
+ */
+std::shared_ptr<AttributeVector>
+make_attribute(bool filter)
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int32_t> dist(0, 999);
+    std::vector<int32_t> values(num_docs - 1);
+    for (auto& value : values) {
+        value = dist(gen);
+    }
+    return AttributeBuilder("int32", Config(BasicType::INT32).setIsFilter(filter)).fill(values).get();
+}
+
+uint32_t
+seek_all(SearchIterator& itr)
+{
+    uint32_t hits = 0;
+    itr.initRange(1, num_docs);
+    for (uint32_t docid = itr.seekFirst(1); !itr.isAtEnd(); docid = itr.seekNext(docid + 1)) {
+        ++hits;
+    }
+    return hits;
+}
+
+uint32_t
+get_hits(SearchIterator& itr)
+{
+    itr.initRange(1, num_docs);
+    return itr.get_hits(1)->countTrueBits();
+}
+
+void
+benchmark(const AttributeVector& attr, uint32_t per_mille, const char* label, uint32_t (*scan)(SearchIterator&))
+{
+    std::string term = "[0;" + std::to_string(per_mille - 1) + "]";
+    auto sc = attr.getSearch(std::make_unique<QueryTermSimple>(term, QueryTermSimple::Type::WORD), SearchContextParams());
+    TermFieldMatchData tfmd;
+    auto itr = sc->createIterator(&tfmd, true);
+    uint32_t hits = 0;
+    vespalib::BenchmarkTimer timer(1.0);
+    while (timer.has_budget()) {
+        timer.before();
+        hits = scan(*itr);
+        timer.after();
+    }
+    double min_time = timer.min_time();
+    fprintf(stderr, "%-12s %-8s %4u per mille: %8u hits in %7.3f ms (%5.2f ns/doc, %7.2f ns/hit)\n",
+            attr.getIsFilter() ? "filter" : "normal", label, per_mille, hits, min_time * 1000.0,
+            min_time * 1e9 / num_docs, (hits != 0) ? min_time * 1e9 / hits : 0.0);
+    EXPECT_LT(0u, hits);
+}
+
+}
+
+TEST(SingleNumericSearchBenchmark, strict_range_search_with_sparse_and_dense_hits)
+{
+    for (bool filter : {false, true}) {
+        auto attr = make_attribute(filter);
+        for (uint32_t per_mille : {1, 10, 100, 500, 900, 1000}) {
+            benchmark(*attr, per_mille, "seek", seek_all);
+            benchmark(*attr, per_mille, "get_hits", get_hits);
+        }
+    }
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -29,6 +29,7 @@ std::string source_dir = get_source_dir();
 std::string vespa_dir = source_dir + "/" + "../../../../..";
 std::string simple_model = vespa_dir + "/" + "eval/src/tests/tensor/onnx_wrapper/simple.onnx";
 std::string dynamic_model = vespa_dir + "/" + "eval/src/tests/tensor/onnx_wrapper/dynamic.onnx";
+std::string batched_model = vespa_dir + "/" + "eval/src/tests/tensor/onnx_wrapper/batched.onnx";
 std::string strange_names_model = source_dir + "/" + "strange_names.onnx";
 std::string fragile_model = source_dir + "/" + "fragile.onnx";
 
@@ -175,6 +176,33 @@ TEST_F(OnnxFeatureTest, fragile_model_can_be_evaluated) {
     EXPECT_EQ(get(3), TensorSpec::from_expr("tensor<float>(d0[2]):[6,15]"));
 }
 
+TEST_F(OnnxFeatureTest, onnx_model_is_not_evaluated_in_batches_by_default) {
+    add_expr("in1", "tensor<float>(a[1],b[3]):[[docid,2,3]]");
+    add_expr("in2", "tensor(a[1],b[3]):[[1,1,1]]");
+    add_onnx(OnnxModel("batched", batched_model));
+    compile(onnx_feature("batched"));
+    EXPECT_FALSE(program.has_batch_executors());
+    EXPECT_EQ(get("onnx(batched).dot", 1), TensorSpec::from_expr("tensor<float>(d0[1],d1[1]):[[6]]"));
+}
+
+TEST_F(OnnxFeatureTest, onnx_model_with_batch_dimension_can_be_evaluated_in_batches) {
+    add_expr("in1", "tensor<float>(a[1],b[3]):[[docid,2,3]]");
+    add_expr("in2", "tensor(a[1],b[3]):[[1,1,1]]");
+    add_onnx(OnnxModel("batched", batched_model));
+    indexEnv.getProperties().add(indexproperties::eval::OnnxBatchSize::NAME, "2");
+    compile(onnx_feature("batched"));
+    ASSERT_TRUE(program.has_batch_executors());
+    program.begin_batch();
+    for (uint32_t docid: {1, 3, 5}) {
+        program.add_to_batch(docid);
+    }
+    program.end_batch();
+    for (uint32_t docid: {1, 3, 5, 6}) {
+        EXPECT_EQ(get("onnx(batched).sum", docid), TensorSpec::from_expr(fmt("tensor<float>(d0[1],d1[3]):[[%u,3,4]]", docid + 1)));
+        EXPECT_EQ(get("onnx(batched).dot", docid), TensorSpec::from_expr(fmt("tensor<float>(d0[1],d1[1]):[[%u]]", docid + 5)));
+    }
+}
+
 struct MyIssues : Issue::Handler {
     std::vector<std::string> list;
     Issue::Binding capture;
@@ -6,6 +6,7 @@
 #include <vespa/eval/eval/value.h>
 #include <vespa/eval/eval/value_codec.h>
 #include <vespa/eval/eval/test/value_compare.h>
+#include <vespa/eval/streamed/streamed_value_view.h>
 #include <vespa/searchcommon/attribute/config.h>
 #include <vespa/searchlib/attribute/attributefactory.h>
 #include <vespa/searchlib/attribute/attributevector.h>
@@ -29,6 +30,7 @@ using search::tensor::DirectTensorAttribute;
 using search::AttributeVector;
 using vespalib::eval::Function;
 using vespalib::eval::SimpleValue;
+using vespalib::eval::StreamedValueView;
 using vespalib::eval::TensorSpec;
 using vespalib::eval::Value;
 using vespalib::eval::ValueType;
@@ -53,11 +55,14 @@ struct ExecFixture
 {
     BlueprintFactory factory;
     FtFeatureTest test;
-    ExecFixture(const std::string &feature)
+    ExecFixture(const std::string &feature, bool use_streamed_tensor = false)
         : factory(),
           test(factory, feature)
     {
         setup_search_features(factory);
+        if (use_streamed_tensor) {
+            test.getIndexEnv().getProperties().add(eval::UseStreamedTensorAttributes::NAME, "true");
+        }
         setupAttributeVectors();
         setupQueryEnvironment();
         EXPECT_TRUE(test.setup());
@@ -95,10 +100,12 @@ struct ExecFixture
         attrs.push_back(createTensorAttribute("directattr", "tensor(x{})", true));
         attrs.push_back(createStringAttribute("singlestr"));
         attrs.push_back(createTensorAttribute("wrongtype", "tensor(y{})"));
+        attrs.push_back(createTensorAttribute("mixedattr", "tensor<float>(x{},y[2])"));
         addAttributeField("null");
         setAttributeTensorType("tensorattr", "tensor(x{})");
         setAttributeTensorType("directattr", "tensor(x{})");
         setAttributeTensorType("wrongtype", "tensor(x{})");
+        setAttributeTensorType("mixedattr", "tensor<float>(x{},y[2])");
         setAttributeTensorType("null", "tensor(x{})");
 
         for (const auto &attr : attrs) {
@@ -121,6 +128,12 @@ struct ExecFixture
                                                  .add({{"x", "c"}}, 7));
         tensorAttr->setTensor(1, *doc_tensor);
         directAttr->setTensor(1, *doc_tensor);
+        auto mixed_tensor = SimpleValue::from_spec(TensorSpec("tensor<float>(x{},y[2])")
+                                                   .add({{"x", "a"}, {"y", 0}}, 1)
+                                                   .add({{"x", "a"}, {"y", 1}}, 2)
+                                                   .add({{"x", "b"}, {"y", 0}}, 3)
+                                                   .add({{"x", "b"}, {"y", 1}}, 4));
+        dynamic_cast<TensorAttribute &>(*attrs.back()).setTensor(1, *mixed_tensor);
 
         for (const auto &attr : attrs) {
             attr->commit();
@@ -182,6 +195,33 @@ TEST(TensorTest, require_that_direct_tensor_attribute_can_be_extracted_in_attrib
               .add({{"x", "a"}}, 3), spec_from_value(f.execute()));
 }
 
+TEST(TensorTest, require_that_tensor_attribute_can_be_extracted_as_streamed_view_in_attribute_feature)
+{
+    ExecFixture f("attribute(tensorattr)", true);
+    const Value &value = f.execute();
+    EXPECT_TRUE(dynamic_cast<const StreamedValueView *>(&value) != nullptr);
+    EXPECT_EQ(TensorSpec("tensor(x{})")
+              .add({{"x", "b"}}, 5)
+              .add({{"x", "c"}}, 7)
+              .add({{"x", "a"}}, 3), spec_from_value(value));
+}
+
+TEST(TensorTest, require_that_mixed_tensor_attribute_can_be_extracted_as_streamed_view_in_attribute_feature)
+{
+    auto expect = TensorSpec("tensor<float>(x{},y[2])")
+                  .add({{"x", "a"}, {"y", 0}}, 1)
+                  .add({{"x", "a"}, {"y", 1}}, 2)
+                  .add({{"x", "b"}, {"y", 0}}, 3)
+                  .add({{"x", "b"}, {"y", 1}}, 4);
+    ExecFixture f1("attribute(mixedattr)");
+    EXPECT_TRUE(dynamic_cast<const StreamedValueView *>(&f1.execute()) == nullptr);
+    EXPECT_EQ(expect, spec_from_value(f1.execute()));
+    ExecFixture f2("attribute(mixedattr)", true);
+    EXPECT_TRUE(dynamic_cast<const StreamedValueView *>(&f2.execute()) != nullptr);
+    EXPECT_EQ(expect, spec_from_value(f2.execute()));
+    EXPECT_EQ(*make_empty("tensor<float>(x{},y[2])"), f2.execute(2));
+}
+
 TEST(TensorTest, require_that_tensor_from_query_can_be_extracted_as_tensor_in_query_feature)
 {
     ExecFixture f("query(tensorquery)");
@@ -243,6 +243,30 @@ TEST(PropertiesTest, test_stuff)
             p.add("vespa.eval.use_fast_forest", "true");
             EXPECT_EQ(eval::UseFastForest::check(p), true);
         }
+        { // vespa.eval.fast_forest_batch_size
+            EXPECT_EQ(eval::FastForestBatchSize::NAME, std::string("vespa.eval.fast_forest_batch_size"));
+            EXPECT_EQ(eval::FastForestBatchSize::DEFAULT_VALUE, 0u);
+            Properties p;
+            EXPECT_EQ(eval::FastForestBatchSize::lookup(p), 0u);
+            p.add("vespa.eval.fast_forest_batch_size", "64");
+            EXPECT_EQ(eval::FastForestBatchSize::lookup(p), 64u);
+        }
+        { // vespa.eval.use_streamed_tensor_attributes
+            EXPECT_EQ(eval::UseStreamedTensorAttributes::NAME, std::string("vespa.eval.use_streamed_tensor_attributes"));
+            EXPECT_EQ(eval::UseStreamedTensorAttributes::DEFAULT_VALUE, false);
+            Properties p;
+            EXPECT_EQ(eval::UseStreamedTensorAttributes::check(p), false);
+            p.add("vespa.eval.use_streamed_tensor_attributes", "true");
+            EXPECT_EQ(eval::UseStreamedTensorAttributes::check(p), true);
+        }
+        { // vespa.eval.pure_feature_cache_size
+            EXPECT_EQ(eval::PureFeatureCacheSize::NAME, std::string("vespa.eval.pure_feature_cache_size"));
+            EXPECT_EQ(eval::PureFeatureCacheSize::DEFAULT_VALUE, 0u);
+            Properties p;
+            EXPECT_EQ(eval::PureFeatureCacheSize::lookup(p), 0u);
+            p.add("vespa.eval.pure_feature_cache_size", "1000");
+            EXPECT_EQ(eval::PureFeatureCacheSize::lookup(p), 1000u);
+        }
         { // vespa.rank.firstphase
             EXPECT_EQ(rank::FirstPhase::NAME, std::string("vespa.rank.firstphase"));
             EXPECT_EQ(rank::FirstPhase::DEFAULT_VALUE, std::string("nativeRank"));
@@ -99,6 +99,16 @@ struct Fixture {
         indexEnv.getProperties().add(indexproperties::eval::UseFastForest::NAME, "true");
         return *this;
     }
+    Fixture &fast_forest_batch_size(uint32_t value) {
+        indexEnv.getProperties().add(indexproperties::eval::FastForestBatchSize::NAME,
+                                     vespalib::make_string("%u", value));
+        return *this;
+    }
+    Fixture &pure_feature_cache_size(uint32_t value) {
+        indexEnv.getProperties().add(indexproperties::eval::PureFeatureCacheSize::NAME,
+                                     vespalib::make_string("%u", value));
+        return *this;
+    }
     Fixture &add_expr(const std::string &name, const std::string &expr) {
         std::string feature_name = expr_feature(name);
         std::string expr_name = feature_name + ".rankingScript";
@@ -355,7 +365,7 @@ TEST(RankProgramTest, non_lazy_ranking_expression_always_calculates_all_inputs)
     EXPECT_EQ(6u, count_features(f1.program));
     EXPECT_EQ(0u, count_const_features(f1.program));
     EXPECT_EQ(f1.track_cnt, 0u);
-    EXPECT_EQ(f1.get(expr_feature("rank"), 5), 1.0);
+    EXPECT_EQ(f1.get(5), 1.0);
     EXPECT_EQ(f1.track_cnt, 2u);
     EXPECT_EQ(f1.get(expr_feature("rank"), 15), 2.0);
     EXPECT_EQ(f1.track_cnt, 4u);
@@ -448,6 +458,72 @@ TEST(RankProgramTest, fast_forest_gbdt_evaluation_is_pure)
     EXPECT_EQ(f1.final_executor_name(), "search::features::FastForestExecutor");
 }
 
+const std::string docid_tree_expr = "if(docid<3,1,2)+if(docid<5,10,20)+if(value(2)<1,100,200)";
+
+TEST(RankProgramTest, fast_forest_gbdt_evaluation_is_not_batched_by_default)
+{
+    Fixture f1;
+    f1.use_fast_forest().add_expr("rank", docid_tree_expr).compile();
+    EXPECT_FALSE(f1.program.has_batch_executors());
+    EXPECT_EQ(f1.final_executor_name(), "search::features::FastForestExecutor");
+}
+
+TEST(RankProgramTest, fast_forest_gbdt_evaluation_can_be_batched)
+{
+    Fixture f1;
+    f1.use_fast_forest().fast_forest_batch_size(2).add_expr("rank", docid_tree_expr).compile();
+    ASSERT_TRUE(f1.program.has_batch_executors());
+    EXPECT_EQ(f1.final_executor_name(), "search::features::BatchFastForestExecutor");
+    f1.program.begin_batch();
+    for (uint32_t docid: {1, 3, 5}) {
+        f1.program.add_to_batch(docid);
+    }
+    f1.program.end_batch();
+    EXPECT_EQ(f1.get(1), 211.0);
+    EXPECT_EQ(f1.get(3), 212.0);
+    EXPECT_EQ(f1.get(5), 222.0);
+    EXPECT_EQ(f1.get(4), 212.0); // not in batch
+}
+
+TEST(RankProgramTest, pure_features_are_not_memoized_by_default)
+{
+    Fixture f1;
+    f1.add_expr("cat", "docid%3").add("track(rankingExpression(cat))").compile();
+    for (uint32_t docid = 1; docid <= 9; ++docid) {
+        EXPECT_EQ(f1.get("track(rankingExpression(cat))", docid), double(docid % 3));
+    }
+    EXPECT_EQ(f1.track_cnt, 9u);
+    EXPECT_EQ(f1.program.get_memoization_stats().num_features, 0u);
+}
+
+TEST(RankProgramTest, pure_features_can_be_memoized)
+{
+    Fixture f1;
+    f1.pure_feature_cache_size(10).add_expr("cat", "docid%3").add("track(rankingExpression(cat))").compile();
+    for (uint32_t docid = 1; docid <= 9; ++docid) {
+        EXPECT_EQ(f1.get("track(rankingExpression(cat))", docid), double(docid % 3));
+    }
+    EXPECT_EQ(f1.track_cnt, 3u);
+    auto stats = f1.program.get_memoization_stats();
+    EXPECT_EQ(stats.num_features, 2u); // rankingExpression(cat) and track
+    EXPECT_EQ(stats.num_entries, 9u + 3u);
+    EXPECT_EQ(stats.hits, 6u);
+    EXPECT_EQ(stats.misses, 9u + 3u);
+    EXPECT_DOUBLE_EQ(stats.hit_rate(), 6.0 / 18.0);
+}
+
+TEST(RankProgramTest, memoized_features_are_calculated_when_cache_is_full)
+{
+    Fixture f1;
+    f1.pure_feature_cache_size(2).add("track(mysum(docid,value(3)))").compile();
+    EXPECT_EQ(f1.program.get_memoization_stats().num_features, 2u);
+    for (uint32_t docid: {1, 2, 1, 2, 3, 1, 3, 4}) {
+        EXPECT_EQ(f1.get(docid), double(docid + 3));
+    }
+    EXPECT_EQ(f1.track_cnt, 4u);
+    EXPECT_EQ(f1.program.get_memoization_stats().num_entries, 4u);
+}
+
 TEST(RankProgramTest, rank_program_can_be_profiled)
 {
     Fixture f1;
@@ -233,6 +233,11 @@ TEST_F("testAggregatorResults", Fixture("testAggregatorResults")) {
     stddev.setExpression(MU<ConstantNode>(MU<Int64ResultNode>(67)))
             .aggregate(DocId(42), HitRank(21));
     f.checkObject(stddev);
+    QuantileAggregationResult quantile;
+    quantile.setQuantiles({0.5, 0.99});
+    quantile.setExpression(MU<ConstantNode>(MU<Int64ResultNode>(67)))
+            .aggregate(DocId(42), HitRank(21));
+    f.checkObject(quantile);
 }
 
 TEST_F("testHitCollection", Fixture("testHitCollection")) {
@@ -3,6 +3,7 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/searchlib/aggregation/perdocexpression.h>
 #include <vespa/searchlib/aggregation/aggregation.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
 #include <vespa/searchlib/attribute/extendableattributes.h>
 #include <vespa/searchlib/attribute/attributemanager.h>
 #include <vespa/searchlib/aggregation/hitsaggregationresult.h>
@@ -12,6 +13,7 @@
 #include <vespa/searchlib/expression/documentfieldnode.h>
 #include <vespa/searchlib/expression/fixedwidthbucketfunctionnode.h>
 #include <vespa/searchlib/test/make_attribute_map_lookup_node.h>
+#include <vespa/searchcommon/attribute/config.h>
 #include <vespa/searchcommon/common/undefinedvalues.h>
 #include <algorithm>
 #include <cmath>
@@ -717,6 +719,84 @@ TEST("testAggregationGroupCapping")
 
 }
 
+TEST("Verify that counting hits per single value attribute respects rank and group capping")
+{
+    AggregationContext ctx;
+    ctx.add(IntAttrBuilder("attr").add(7).add(3).add(7).add(5).add(3).add(7).sp());
+    ctx.result().add(0, 10).add(1, 20).add(2, 30).add(3, 40).add(4, 50).add(5, 60);
+
+    auto count = [](uint64_t c) {
+        CountAggregationResult result(c);
+        result.setExpression(MU<ConstantNode>(MU<Int64ResultNode>(0)));
+        return result;
+    };
+    Grouping baseRequest = Grouping().setFirstLevel(0).setLastLevel(1)
+                           .addLevel(std::move(GroupingLevel().setExpression(MU<AttributeNode>("attr"))
+                                                              .addResult(count(0))));
+    {
+        Group expect = Group()
+                       .addChild(Group().setId(Int64ResultNode(3)).setRank(RawRank(50)).addResult(count(2)))
+                       .addChild(Group().setId(Int64ResultNode(5)).setRank(RawRank(40)).addResult(count(1)))
+                       .addChild(Group().setId(Int64ResultNode(7)).setRank(RawRank(60)).addResult(count(3)));
+        EXPECT_TRUE(testAggregation(ctx, baseRequest, expect));
+    }
+    { // hits are visited in rank order, so the group for value 5 is not created
+        Grouping request = baseRequest;
+        request.levels()[0].setMaxGroups(2);
+        Group expect = Group()
+                       .addChild(Group().setId(Int64ResultNode(3)).setRank(RawRank(50)).addResult(count(2)))
+                       .addChild(Group().setId(Int64ResultNode(7)).setRank(RawRank(60)).addResult(count(3)));
+        EXPECT_TRUE(testAggregation(ctx, request, expect));
+    }
+}
+
+TEST("Verify that counting hits per enum handle gives the same groups as the generic path")
+{
+    AggregationContext ctx;
+    Config cfg(BasicType::STRING, CollectionType::SINGLE);
+    auto attr = std::dynamic_pointer_cast<StringAttribute>(AttributeFactory::createAttribute("sattr", cfg));
+    ASSERT_TRUE(attr);
+    attr->addReservedDoc();
+    for (const char *value : {"b", "a", "b", "c", "a", "b"}) {
+        DocId docId = 0;
+        attr->addDoc(docId);
+        attr->update(docId, value);
+    }
+    attr->commit();
+    ASSERT_TRUE(attr->hasEnum());
+    ctx.add(attr);
+    ctx.result().add(1, 10).add(2, 20).add(3, 30).add(4, 40).add(5, 50).add(6, 60);
+
+    auto count = [](uint64_t c) {
+        CountAggregationResult result(c);
+        result.setExpression(MU<ConstantNode>(MU<Int64ResultNode>(0)));
+        return result;
+    };
+    auto make_request = [&count](bool useEnumOptimization, int64_t maxGroups) {
+        auto node = MU<AttributeNode>("sattr");
+        node->enableEnumOptimization(useEnumOptimization);
+        return Grouping().setFirstLevel(0).setLastLevel(1)
+                         .addLevel(std::move(GroupingLevel().setMaxGroups(maxGroups).setExpression(std::move(node))
+                                                            .addResult(count(0))));
+    };
+    for (bool useEnumOptimization : {true, false}) {
+        TEST_STATE(useEnumOptimization ? "enum handles" : "generic path");
+        {
+            Group expect = Group()
+                           .addChild(Group().setId(StringResultNode("a")).setRank(RawRank(50)).addResult(count(2)))
+                           .addChild(Group().setId(StringResultNode("b")).setRank(RawRank(60)).addResult(count(3)))
+                           .addChild(Group().setId(StringResultNode("c")).setRank(RawRank(40)).addResult(count(1)));
+            EXPECT_TRUE(testAggregation(ctx, make_request(useEnumOptimization, -1), expect));
+        }
+        { // hits are visited in rank order, so the group for "c" is not created
+            Group expect = Group()
+                           .addChild(Group().setId(StringResultNode("a")).setRank(RawRank(50)).addResult(count(2)))
+                           .addChild(Group().setId(StringResultNode("b")).setRank(RawRank(60)).addResult(count(3)));
+            EXPECT_TRUE(testAggregation(ctx, make_request(useEnumOptimization, 2), expect));
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 /**
@@ -749,6 +829,31 @@ TEST("testMergeSimpleSum")
     EXPECT_TRUE(testMerge(a, b, expect));
 }
 
+TEST("testMergeWithEmptyPartialResult")
+{
+    Grouping a = Grouping()
+                 .addLevel(createGL(MU<AttributeNode>("foo"), MU<AttributeNode>("bar")))
+                 .setRoot(Group()
+                          .addChild(Group().setId(Int64ResultNode(1))
+                                    .addResult(SumAggregationResult().setExpression(MU<AttributeNode>("bar")).setResult(Int64ResultNode(10))))
+                          .addChild(Group().setId(Int64ResultNode(2))
+                                    .addResult(SumAggregationResult().setExpression(MU<AttributeNode>("bar")).setResult(Int64ResultNode(20)))));
+
+    // A match thread that did not see any hits produces a root without children.
+    Grouping b = Grouping()
+                 .addLevel(createGL(MU<AttributeNode>("foo"), MU<AttributeNode>("bar")))
+                 .setRoot(Group());
+
+    Group expect = Group()
+                   .addChild(Group().setId(Int64ResultNode(1))
+                             .addResult(SumAggregationResult().setExpression(MU<AttributeNode>("bar")).setResult(Int64ResultNode(10))))
+                   .addChild(Group().setId(Int64ResultNode(2))
+                             .addResult(SumAggregationResult().setExpression(MU<AttributeNode>("bar")).setResult(Int64ResultNode(20))));
+
+    EXPECT_TRUE(testMerge(a, b, expect));
+    EXPECT_TRUE(testMerge(b, a, expect));
+}
+
 TEST("Verify that frozen levels are not touched during merge.")
 {
     Grouping request;
@@ -0,0 +1,88 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+// Unit tests for kllsketch.
+
+#include <vespa/searchlib/grouping/kllsketch.h>
+#include <vespa/vespalib/objects/nboserializer.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/testkit/test_master.hpp>
+#include <random>
+
+#include <vespa/log/log.h>
+LOG_SETUP("kllsketch_test");
+
+using vespalib::NBOSerializer;
+using vespalib::nbostream;
+using namespace search;
+
+namespace {
+
+// Aggregates a random permutation of the values 0 .. n-1.
+void
+fill(KllSketch &sketch, uint32_t n, uint32_t seed) {
+    std::vector<double> values;
+    for (uint32_t i = 0; i < n; ++i) {
+        values.push_back(i);
+    }
+    std::shuffle(values.begin(), values.end(), std::mt19937(seed));
+    for (double value : values) {
+        sketch.aggregate(value);
+    }
+}
+
+TEST("require that quantiles are exact for small inputs") {
+    KllSketch sketch;
+    EXPECT_TRUE(std::isnan(sketch.quantile(0.5)));
+    for (double value : {5.0, 1.0, 4.0, 2.0, 3.0}) {
+        sketch.aggregate(value);
+    }
+    EXPECT_EQUAL(5u, sketch.getCount());
+    EXPECT_EQUAL(1.0, sketch.quantile(0.0));
+    EXPECT_EQUAL(3.0, sketch.quantile(0.5));
+    EXPECT_EQUAL(5.0, sketch.quantile(1.0));
+}
+
+TEST("require that quantiles of large inputs are within the rank error") {
+    KllSketch sketch;
+    fill(sketch, 1000000, 42);
+    EXPECT_EQUAL(1000000u, sketch.getCount());
+    EXPECT_LESS(sketch.getSize(), 1000u);
+    for (double q : {0.01, 0.1, 0.5, 0.9, 0.99}) {
+        EXPECT_APPROX(q * 1000000, sketch.quantile(q), 0.02 * 1000000);
+    }
+}
+
+TEST("require that sketches can be merged") {
+    KllSketch a;
+    KllSketch b;
+    fill(a, 100000, 1);
+    for (uint32_t i = 100000; i < 200000; ++i) {
+        b.aggregate(i);
+    }
+    a.merge(b);
+    EXPECT_EQUAL(200000u, a.getCount());
+    EXPECT_APPROX(100000.0, a.quantile(0.5), 0.02 * 200000);
+    EXPECT_APPROX(190000.0, a.quantile(0.95), 0.02 * 200000);
+    double median = a.quantile(0.5);
+    a.merge(KllSketch());
+    EXPECT_EQUAL(200000u, a.getCount());
+    EXPECT_EQUAL(median, a.quantile(0.5));
+}
+
+TEST("require that sketches can be (de)serialized") {
+    KllSketch sketch;
+    fill(sketch, 10000, 7);
+    nbostream stream;
+    NBOSerializer serializer(stream);
+    sketch.serialize(serializer);
+    KllSketch copy(10);
+    copy.deserialize(serializer);
+    EXPECT_TRUE(stream.empty());
+    EXPECT_TRUE(sketch == copy);
+    EXPECT_EQUAL(sketch.getSize(), copy.getSize());
+    EXPECT_EQUAL(sketch.quantile(0.5), copy.quantile(0.5));
+}
+
+}  // namespace
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,113 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/fieldvalue/stringfieldvalue.h>
+#include <vespa/document/repo/configbuilder.h>
+#include <vespa/searchcommon/common/schema.h>
+#include <vespa/searchlib/index/field_length_calculator.h>
+#include <vespa/searchlib/memoryindex/field_index_remover.h>
+#include <vespa/searchlib/memoryindex/field_inverter.h>
+#include <vespa/searchlib/memoryindex/i_ordered_field_index_inserter.h>
+#include <vespa/searchlib/memoryindex/word_store.h>
+#include <vespa/searchlib/test/doc_builder.h>
+#include <vespa/searchlib/test/schema_builder.h>
+#include <vespa/searchlib/test/string_field_builder.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <random>
+
+using document::DataType;
+using document::Document;
+using search::index::FieldLengthCalculator;
+using search::index::Schema;
+using search::memoryindex::FieldIndexRemover;
+using search::memoryindex::FieldInverter;
+using search::memoryindex::IOrderedFieldIndexInserter;
+using search::memoryindex::WordStore;
+using search::test::DocBuilder;
+using search::test::SchemaBuilder;
+using search::test::StringFieldBuilder;
+
+namespace {
+
+constexpr uint32_t num_docs = 10000;
+constexpr uint32_t words_per_doc = 200;
+constexpr uint32_t vocabulary_size = 50000;
+constexpr uint32_t docs_per_batch = 100;
+
+/*
+ * Inserter that only counts calls, to measure the cost of inversion without posting list updates.
+ */
+class CountingInserter : public IOrderedFieldIndexInserter {
+public:
+    size_t words = 0;
+    size_t adds = 0;
+    void setNextWord(const std::string_view) override { ++words; }
+    void add(uint32_t, const search::index::DocIdAndFeatures &) override { ++adds; }
+    vespalib::datastore::EntryRef getWordRef() const override { return {}; }
+    void remove(uint32_t) override { }
+    void flush() override { }
+    void commit() override { }
+    void rewind() override { }
+};
+
+std::string
+make_text(std::mt19937 &gen)
+{
+    // Skewed word distribution, approximating natural language text.
+    std::exponential_distribution<double> dist(8.0);
+    std::string text;
+    for (uint32_t i = 0; i < words_per_doc; ++i) {
+        auto word_num = static_cast<uint32_t>(dist(gen) * vocabulary_size) % vocabulary_size;
+        if (!text.empty()) {
+            text.append(" ");
+        }
+        text.append("w" + std::to_string(word_num));
+    }
+    return text;
+}
+
+}
+
+TEST(FieldInverterBenchmark, invert_and_push_documents)
+{
+    DocBuilder b([](auto& header) { header.addField("f0", DataType::T_STRING); });
+    Schema schema(SchemaBuilder(b).add_all_indexes().build());
+    WordStore word_store;
+    FieldIndexRemover remover(word_store);
+    CountingInserter inserter;
+    FieldLengthCalculator calculator;
+    FieldInverter inverter(schema, 0, remover, inserter, calculator);
+
+    std::mt19937 gen(42);
+    StringFieldBuilder sfb(b);
+    std::vector<std::unique_ptr<Document>> docs;
+    for (uint32_t i = 0; i < num_docs; ++i) {
+        auto doc = b.make_document("id:ns:searchdocument::" + std::to_string(i));
+        doc->setValue("f0", sfb.tokenize(make_text(gen)).build());
+        docs.emplace_back(std::move(doc));
+    }
+    std::vector<std::unique_ptr<document::FieldValue>> values;
+    for (auto &doc : docs) {
+        values.emplace_back(doc->getValue("f0"));
+    }
+
+    vespalib::BenchmarkTimer timer(5.0);
+    while (timer.has_budget()) {
+        timer.before();
+        for (uint32_t i = 0; i < num_docs; ++i) {
+            inverter.invertField(i + 1, values[i], *docs[i]);
+            if ((i + 1) % docs_per_batch == 0) {
+                inverter.pushDocuments();
+            }
+        }
+        inverter.pushDocuments();
+        timer.after();
+    }
+    double min_time = timer.min_time();
+    fprintf(stderr, "Inverted %u docs with %u words each in %.3f s (%.0f docs/s), %zu words, %zu adds\n",
+            num_docs, words_per_doc, min_time, num_docs / min_time, inserter.words, inserter.adds);
+    EXPECT_LT(0u, inserter.adds);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
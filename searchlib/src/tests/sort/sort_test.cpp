@@ -138,6 +138,28 @@ TEST("testStringSort")
     }
 }
 
+TEST("testStringSortTopN")
+{
+    constexpr size_t N = 0x1000;
+    constexpr size_t topn = 25;
+    std::vector<std::string> strings;
+    unsigned seed(1);
+    for (size_t i(0); i < N; i++) {
+        strings.push_back(std::to_string(rand_r(&seed) % 1000));
+    }
+    Array<LoadedStrings> loaded(N);
+    for (size_t i(0); i < N; i++) {
+        loaded[i] = LoadedStrings(strings[i].c_str());
+    }
+    std::vector<uint32_t> radixScratchPad(N);
+    search::radix_sort(LoadedStrings::ValueRadix(), LoadedStrings::ValueCompare(), search::AlwaysEof<LoadedStrings>(), 1, &loaded[0], N, &radixScratchPad[0], 0, 10, topn);
+    std::vector<std::string> expected(strings);
+    std::sort(expected.begin(), expected.end());
+    for (size_t i(0); i < topn; i++) {
+        EXPECT_EQUAL(expected[i], std::string(loaded[i]._value));
+    }
+}
+
 TEST("testStringCaseInsensitiveSort")
 {
 }
@@ -5,6 +5,7 @@
 #include <vespa/eval/eval/tensor_spec.h>
 #include <vespa/eval/eval/value.h>
 #include <vespa/eval/eval/value_codec.h>
+#include <vespa/vespalib/datastore/compaction_strategy.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/stllike/hash_set.h>
@@ -13,6 +14,8 @@
 
 
 using search::tensor::TensorBufferStore;
+using vespalib::datastore::AtomicEntryRef;
+using vespalib::datastore::CompactionStrategy;
 using vespalib::datastore::EntryRef;
 using vespalib::eval::FastValueBuilderFactory;
 using vespalib::eval::TensorSpec;
@@ -167,6 +170,37 @@ TEST_F(TensorBufferStoreTest, stored_tensor_can_be_encoded_and_stored_as_encoded
     }
 }
 
+TEST_F(TensorBufferStoreTest, compaction_can_be_done_in_steps)
+{
+    auto& tensor_spec = tensor_specs[2];
+    std::vector<AtomicEntryRef> refs;
+    for (uint32_t i = 0; i < 10000; ++i) {
+        refs.emplace_back(store_tensor(tensor_spec));
+    }
+    for (uint32_t i = 0; i < refs.size(); i += 2) {
+        _store.holdTensor(refs[i].load_relaxed());
+        refs[i].store_relaxed(EntryRef());
+    }
+    _store.assign_generation(0);
+    _store.reclaim_memory(1);
+    CompactionStrategy compaction_strategy(0.05, 0.2, 1, 0.1, 3000);
+    _store.update_stat(compaction_strategy);
+    EXPECT_TRUE(_store.consider_compact());
+    uint32_t steps = 0;
+    do {
+        _store.compact_worst(refs, compaction_strategy);
+        ++steps;
+        // Feed continues between the compaction steps.
+        refs.emplace_back(store_tensor(tensor_spec));
+    } while (_store.is_compacting());
+    EXPECT_EQ(4u, steps);
+    for (auto& ref : refs) {
+        if (ref.load_relaxed().valid()) {
+            EXPECT_EQ(tensor_spec, load_tensor_spec(ref.load_relaxed()));
+        }
+    }
+}
+
 TEST_F(TensorBufferStoreTest, get_vectors)
 {
     auto ref = store_tensor(tensor_specs.back());
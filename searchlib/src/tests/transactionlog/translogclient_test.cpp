@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/searchlib/transactionlog/translogclient.h>
 #include <vespa/searchlib/transactionlog/translogserver.h>
+#include <vespa/searchlib/transactionlog/group_syncer.h>
 #include <vespa/searchlib/test/directory_handler.h>
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/objects/identifiable.h>
@@ -908,6 +909,37 @@ TEST("testSync") {
     EXPECT_EQUAL(syncedTo, TOTAL_NUM_ENTRIES);
 }
 
+TEST("test group sync across domains") {
+    const unsigned int NUM_PACKETS = 10;
+    const unsigned int NUM_ENTRIES = 4;
+    const unsigned int TOTAL_NUM_ENTRIES = NUM_PACKETS * NUM_ENTRIES;
+
+    DummyFileHeaderContext fileHeaderContext;
+    test::DirectoryHandler testDir("test_group_sync");
+    TLS tlss(testDir.getDir(), 18377, ".", fileHeaderContext,
+             createDomainConfig(0x1000000).setFSyncOnCommit(true).setGroupSyncMaxLatency(5ms));
+    TransLogClient tls(tlss.transport, "tcp/localhost:18377");
+
+    createDomainTest(tls, "groupsync1", 0);
+    createDomainTest(tls, "groupsync2", 1);
+    auto s1 = openDomainTest(tls, "groupsync1");
+    auto s2 = openDomainTest(tls, "groupsync2");
+    fillDomainTest(s1.get(), NUM_PACKETS, NUM_ENTRIES);
+    fillDomainTest(s2.get(), NUM_PACKETS, NUM_ENTRIES);
+
+    SerialNum syncedTo(0);
+    EXPECT_TRUE(s1->sync(TOTAL_NUM_ENTRIES, syncedTo));
+    EXPECT_EQUAL(syncedTo, TOTAL_NUM_ENTRIES);
+    EXPECT_TRUE(s2->sync(TOTAL_NUM_ENTRIES, syncedTo));
+    EXPECT_EQUAL(syncedTo, TOTAL_NUM_ENTRIES);
+
+    GroupSyncStats stats = tlss.tls.getGroupSyncStats();
+    EXPECT_EQUAL(2 * NUM_PACKETS, stats.batchSize.total());
+    EXPECT_LESS_EQUAL(stats.batchSize.count(), 2 * NUM_PACKETS);
+    EXPECT_LESS_EQUAL(stats.numSyncs, 2 * NUM_PACKETS);
+    EXPECT_EQUAL(0u, tlss.tls.getGroupSyncStats().batchSize.count());
+}
+
 TEST("test truncate on version mismatch") {
     const unsigned int NUM_PACKETS = 3;
     const unsigned int NUM_ENTRIES = 4;
@@ -2,6 +2,7 @@
 
 #include "aggregation.h"
 #include "expressioncountaggregationresult.h"
+#include "quantileaggregationresult.h"
 #include <vespa/searchlib/expression/resultvector.h>
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/vespalib/objects/visit.hpp>
@@ -45,6 +46,7 @@ IMPLEMENT_AGGREGATIONRESULT(AverageAggregationResult, AggregationResult);
 IMPLEMENT_AGGREGATIONRESULT(XorAggregationResult,     AggregationResult);
 IMPLEMENT_AGGREGATIONRESULT(ExpressionCountAggregationResult, AggregationResult);
 IMPLEMENT_AGGREGATIONRESULT(StandardDeviationAggregationResult, AggregationResult);
+IMPLEMENT_AGGREGATIONRESULT(QuantileAggregationResult, AggregationResult);
 
 AggregationResult::AggregationResult() :
     _expressionTree(std::make_shared<ExpressionTree>()),
@@ -629,6 +631,88 @@ StandardDeviationAggregationResult::visitMembers(vespalib::ObjectVisitor &visito
     visit(visitor, "sumOfSquared", _sumOfSquared);
 }
 
+QuantileAggregationResult::QuantileAggregationResult()
+    : AggregationResult(), _quantiles(), _sketch(), _rank()
+{ }
+
+QuantileAggregationResult::~QuantileAggregationResult() = default;
+
+QuantileAggregationResult &
+QuantileAggregationResult::setQuantiles(std::vector<double> quantiles)
+{
+    _quantiles = std::move(quantiles);
+    return *this;
+}
+
+const ResultNode &
+QuantileAggregationResult::onGetRank() const
+{
+    _rank.clear();
+    for (double q : _quantiles) {
+        _rank.push_back(FloatResultNode(_sketch.quantile(q)));
+    }
+    return _rank;
+}
+
+void
+QuantileAggregationResult::onMerge(const AggregationResult &r) {
+    const auto & result = Identifiable::cast<const QuantileAggregationResult &>(r);
+    _sketch.merge(result._sketch);
+}
+
+void
+QuantileAggregationResult::onAggregate(const ResultNode &result) {
+    if (result.isMultiValue()) {
+        const auto & values = static_cast<const ResultNodeVector &>(result);
+        for (size_t i(0), m(values.size()); i < m; i++) {
+            _sketch.aggregate(values.get(i).getFloat());
+        }
+    } else {
+        _sketch.aggregate(result.getFloat());
+    }
+}
+
+void
+QuantileAggregationResult::onReset()
+{
+    _sketch = KllSketch(_sketch.getK());
+}
+
+Serializer &
+QuantileAggregationResult::onSerialize(Serializer & os) const
+{
+    AggregationResult::onSerialize(os);
+    uint32_t numQuantiles = _quantiles.size();
+    os << numQuantiles;
+    for (double q : _quantiles) {
+        os << q;
+    }
+    _sketch.serialize(os);
+    return os;
+}
+
+Deserializer &
+QuantileAggregationResult::onDeserialize(Deserializer & is)
+{
+    AggregationResult::onDeserialize(is);
+    uint32_t numQuantiles;
+    is >> numQuantiles;
+    _quantiles.resize(numQuantiles);
+    for (double & q : _quantiles) {
+        is >> q;
+    }
+    _sketch.deserialize(is);
+    return is;
+}
+
+void
+QuantileAggregationResult::visitMembers(vespalib::ObjectVisitor &visitor) const
+{
+    AggregationResult::visitMembers(visitor);
+    visit(visitor, "quantiles", _quantiles);
+    visit(visitor, "count", _sketch.getCount());
+}
+
 }
 
 // this function was added by ../../forcelink.sh
@@ -0,0 +1,113 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "attribute_group_counter.h"
+#include "countaggregationresult.h"
+#include "grouping.h"
+#include <vespa/searchlib/expression/attributenode.h>
+#include <vespa/searchlib/expression/constantnode.h>
+#include <vespa/searchlib/expression/enumresultnode.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+
+namespace search::aggregation {
+
+using expression::AttributeNode;
+using expression::ConstantNode;
+using expression::EnumResultNode;
+using expression::ExpressionNode;
+using expression::Int64ResultNode;
+using expression::IntegerResultNode;
+using expression::ResultNode;
+
+namespace {
+
+bool
+onlyCountsHits(const Group & prototype)
+{
+    for (size_t i(0), m(prototype.getAggrSize()); i < m; i++) {
+        const AggregationResult & aggr = prototype.getAggregationResult(i);
+        if (!aggr.getClass().equal(CountAggregationResult::classId)) {
+            return false;
+        }
+        const ExpressionNode * expr = aggr.getExpression();
+        if ((expr == nullptr) || !expr->getClass().equal(ConstantNode::classId) ||
+            (expr->getResult() == nullptr) || expr->getResult()->isMultiValue())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+AttributeGroupCounter::UP
+AttributeGroupCounter::create(const Grouping & grouping)
+{
+    const Grouping::GroupingLevelList & levels = grouping.getLevels();
+    if ((levels.size() != 1) || (grouping.getFirstLevel() != 0) || (grouping.getLastLevel() < 1) ||
+        (grouping.getRoot().getChildrenSize() != 0))
+    {
+        return {};
+    }
+    const GroupingLevel & level = levels[0];
+    const ExpressionNode * root = level.getExpression().getRoot();
+    if (level.isFrozen() || (root == nullptr) || !root->getClass().equal(AttributeNode::classId)) {
+        return {};
+    }
+    const attribute::IAttributeVector * attribute = static_cast<const AttributeNode &>(*root).getAttribute();
+    const ResultNode * result = level.getExpression().getResult();
+    if ((attribute == nullptr) || attribute->hasMultiValue() || (result == nullptr) ||
+        !onlyCountsHits(level.getGroupPrototype()))
+    {
+        return {};
+    }
+    if (result->inherits(EnumResultNode::classId)) {
+        return std::make_unique<AttributeGroupCounter>(*attribute, level, true);
+    }
+    if (result->inherits(IntegerResultNode::classId) && attribute->isIntegerType()) {
+        return std::make_unique<AttributeGroupCounter>(*attribute, level, false);
+    }
+    return {};
+}
+
+AttributeGroupCounter::AttributeGroupCounter(const attribute::IAttributeVector & attribute, const GroupingLevel & level,
+                                             bool isEnum)
+    : _attribute(attribute),
+      _level(level),
+      _enumRefs(isEnum ? attribute.make_enum_read_view() : EnumRefs()),
+      _isEnum(isEnum),
+      _index(),
+      _entries()
+{
+}
+
+AttributeGroupCounter::~AttributeGroupCounter() = default;
+
+bool
+AttributeGroupCounter::allowMoreGroups(size_t numGroups) const noexcept
+{
+    return _level.allowMoreGroups(numGroups);
+}
+
+void
+AttributeGroupCounter::populate(Group & root) const
+{
+    std::unique_ptr<ResultNode> id(_level.getExpression().getResult()->clone());
+    for (const Entry & entry : _entries) {
+        if (_isEnum) {
+            id->set(EnumResultNode(entry.key));
+        } else {
+            id->set(Int64ResultNode(entry.key));
+        }
+        auto group = std::make_unique<Group>(_level.getGroupPrototype());
+        group->setId(*id);
+        group->setRank(entry.rank);
+        for (size_t i(0), m(group->getAggrSize()); i < m; i++) {
+            auto & count = static_cast<CountAggregationResult &>(group->getAggregationResult(i));
+            count.setCount(count.getCount() + entry.count);
+        }
+        root.addChild(std::move(group));
+    }
+}
+
+}
@@ -0,0 +1,88 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/searchcommon/attribute/iattributevector.h>
+#include <vespa/searchlib/common/hitrank.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace search::expression { class ResultNode; }
+
+namespace search::aggregation {
+
+class Group;
+class Grouping;
+class GroupingLevel;
+
+/**
+ * Fast path for the most common grouping, counting hits per value of a single value integer
+ * or enum attribute: one unfrozen level whose groups only contain count() aggregators.
+ * Hits are counted per attribute value directly in a flat hash map instead of evaluating the
+ * expression tree and looking up the group by result node for every hit. The groups are created
+ * in first seen order when all hits are counted, so the result is identical to the generic path.
+ **/
+class AttributeGroupCounter
+{
+public:
+    using UP = std::unique_ptr<AttributeGroupCounter>;
+    using DocId = uint32_t;
+
+    /**
+     * Returns a counter for the given grouping if it is prepared for aggregation and has the
+     * supported shape, otherwise nullptr.
+     **/
+    static UP create(const Grouping & grouping);
+
+    AttributeGroupCounter(const attribute::IAttributeVector & attribute, const GroupingLevel & level, bool isEnum);
+    AttributeGroupCounter(const AttributeGroupCounter &) = delete;
+    AttributeGroupCounter & operator = (const AttributeGroupCounter &) = delete;
+    ~AttributeGroupCounter();
+
+    void count(DocId docId, HitRank rank) {
+        int64_t key = getKey(docId);
+        auto found = _index.find(key);
+        if (found != _index.end()) {
+            Entry & entry = _entries[found->second];
+            ++entry.count;
+            entry.rank = std::max(entry.rank, rank);
+        } else if (allowMoreGroups(_entries.size())) {
+            _index[key] = _entries.size();
+            _entries.push_back({key, 1, std::isnan(rank) ? -HUGE_VAL : rank});
+        }
+    }
+
+    /**
+     * Adds the counted groups as children of the given root.
+     **/
+    void populate(Group & root) const;
+
+private:
+    struct Entry {
+        int64_t  key;
+        uint64_t count;
+        HitRank  rank;
+    };
+    using EnumRefs = attribute::IAttributeVector::EnumRefs;
+
+    int64_t getKey(DocId docId) const {
+        if (!_isEnum) {
+            return _attribute.getInt(docId);
+        }
+        return _enumRefs.empty()
+               ? static_cast<int64_t>(_attribute.getEnum(docId))
+               : static_cast<int64_t>(_enumRefs[docId].load_relaxed().ref());
+    }
+    bool allowMoreGroups(size_t numGroups) const noexcept;
+
+    const attribute::IAttributeVector & _attribute;
+    const GroupingLevel                & _level;
+    EnumRefs                             _enumRefs;
+    bool                                 _isEnum;
+    vespalib::hash_map<int64_t, uint32_t> _index;
+    std::vector<Entry>                   _entries;
+};
+
+}
@@ -210,6 +210,7 @@ Group::partialCopy(const Group & rhs) {
 
 template void Group::aggregate(const Grouping & grouping, uint32_t currentLevel, const DocId & doc, HitRank rank);
 template void Group::aggregate(const Grouping & grouping, uint32_t currentLevel, const document::Document & doc, HitRank rank);
+template void Group::Value::collect(const DocId & doc, HitRank rank);
 
 int
 Group::Value::cmp(const Value & rhs) const {
@@ -391,6 +392,15 @@ void
 Group::Value::merge(const std::vector<GroupingLevel> &levels,
                     uint32_t firstLevel, uint32_t currentLevel, const Value &b)
 {
+    if (b.getChildrenSize() == 0) {
+        // Common when merging partial results from match threads; keep children as is.
+        for (size_t i(getChildrenSize()), m(getAllChildrenSize()); i < m; i++) {
+            destruct(_children[i]);
+            reset(_children[i]);
+        }
+        _childInfo._allChildren = 0;
+        return;
+    }
     auto z = new ChildP[getChildrenSize() + b.getChildrenSize()];
     size_t kept(0);
     ChildP * px = _children;
@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "grouping.h"
+#include "attribute_group_counter.h"
 #include "hitsaggregationresult.h"
 #include <vespa/searchlib/expression/stringresultnode.h>
 #include <vespa/searchlib/expression/enumresultnode.h>
@@ -190,8 +191,16 @@ Grouping::aggregate(DocId from, DocId to)
 {
     preAggregate(false);
     if (to > from) {
-        for(DocId i(from), m(i + getMaxN(to-from)); i < m; i++) {
-            aggregate(i, 0.0);
+        if (auto counter = AttributeGroupCounter::create(*this)) {
+            for(DocId i(from), m(i + getMaxN(to-from)); i < m; i++) {
+                _root.collect(i, 0.0);
+                counter->count(i, 0.0);
+            }
+            counter->populate(_root);
+        } else {
+            for(DocId i(from), m(i + getMaxN(to-from)); i < m; i++) {
+                aggregate(i, 0.0);
+            }
         }
     }
     postProcess();
@@ -229,8 +238,16 @@ Grouping::aggregate(const RankedHit * rankedHit, unsigned int len)
     preAggregate(isOrdered);
     HitsAggregationResult::SetOrdered pred;
     select(pred, pred);
-    for(unsigned int i(0), m(getMaxN(len)); i < m; i++) {
-        aggregate(rankedHit[i].getDocId(), rankedHit[i].getRank());
+    if (auto counter = AttributeGroupCounter::create(*this)) {
+        for(unsigned int i(0), m(getMaxN(len)); i < m; i++) {
+            _root.collect(rankedHit[i].getDocId(), rankedHit[i].getRank());
+            counter->count(rankedHit[i].getDocId(), rankedHit[i].getRank());
+        }
+        counter->populate(_root);
+    } else {
+        for(unsigned int i(0), m(getMaxN(len)); i < m; i++) {
+            aggregate(rankedHit[i].getDocId(), rankedHit[i].getRank());
+        }
     }
     postProcess();
 }
@@ -0,0 +1,37 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "aggregationresult.h"
+#include <vespa/searchlib/expression/resultvector.h>
+#include <vespa/searchlib/grouping/kllsketch.h>
+
+namespace search::aggregation {
+
+/**
+ * Aggregator that estimates quantiles (e.g. p50 and p99) of the aggregated values.
+ * The values are kept in a mergeable KLL sketch, so partial results from several
+ * nodes can be combined without transferring the raw values. The rank is the vector
+ * of the estimated values for the requested quantiles.
+ */
+class QuantileAggregationResult : public AggregationResult
+{
+public:
+    DECLARE_AGGREGATIONRESULT(QuantileAggregationResult);
+    QuantileAggregationResult();
+    ~QuantileAggregationResult() override;
+
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override;
+    QuantileAggregationResult &setQuantiles(std::vector<double> quantiles);
+    const std::vector<double> &getQuantiles() const noexcept { return _quantiles; }
+    double quantile(double q) const { return _sketch.quantile(q); }
+    const KllSketch &getSketch() const noexcept { return _sketch; }
+private:
+    const ResultNode& onGetRank() const override;
+    void onPrepare(const ResultNode&, bool) override { };
+
+    std::vector<double>                       _quantiles;
+    KllSketch                                 _sketch;
+    mutable expression::FloatResultNodeVector _rank;
+};
+
+}
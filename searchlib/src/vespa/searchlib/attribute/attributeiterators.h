@@ -121,6 +121,26 @@ public:
 };
 
 
+/**
+ * The hits in the last block of (at most 64) documents evaluated by a
+ * strict iterator over a search context able to evaluate the term a
+ * block at a time. Later seeks into the block take their hits from the
+ * mask instead of evaluating the term again.
+ */
+class MatchBlockCache
+{
+private:
+    uint32_t _begin;
+    uint32_t _end;
+    uint64_t _bits; // bit i is set if document _begin + i matches
+
+public:
+    MatchBlockCache() noexcept : _begin(0), _end(0), _bits(0) { }
+    // Returns the first matching document in [docId, endId), or endId if there is none.
+    template <typename SC>
+    uint32_t find_next_match(const SC & sc, uint32_t docId, uint32_t endId);
+};
+
 /**
  * This class acts as a strict iterator over documents that are
  * results for the subquery represented by the search context object
@@ -139,11 +159,13 @@ private:
     using AttributeIteratorT<SC>::isAtEnd;
     using AttributeIteratorT<SC>::_weight;
     using Trinary=vespalib::Trinary;
+    MatchBlockCache _match_block;
     void doSeek(uint32_t docId) override;
     Trinary is_strict() const override { return Trinary::True; }
 public:
     AttributeIteratorStrict(const SC &concreteSearchCtx, fef::TermFieldMatchData * matchData)
-        : AttributeIteratorT<SC>(concreteSearchCtx, matchData)
+        : AttributeIteratorT<SC>(concreteSearchCtx, matchData),
+          _match_block()
     { }
 };
 
@@ -157,11 +179,13 @@ private:
     using FilterAttributeIteratorT<SC>::setAtEnd;
     using FilterAttributeIteratorT<SC>::isAtEnd;
     using Trinary=vespalib::Trinary;
+    MatchBlockCache _match_block;
     void doSeek(uint32_t docId) override;
     Trinary is_strict() const override { return Trinary::True; }
 public:
     FilterAttributeIteratorStrict(const SC &concreteSearchCtx, fef::TermFieldMatchData *matchData)
-        : FilterAttributeIteratorT<SC>(concreteSearchCtx, matchData)
+        : FilterAttributeIteratorT<SC>(concreteSearchCtx, matchData),
+          _match_block()
     { }
 };
 
@@ -8,6 +8,9 @@
 #include <vespa/searchlib/fef/termfieldmatchdataposition.h>
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/vespalib/objects/visit.h>
+#include <algorithm>
+#include <bit>
+#include <concepts>
 
 namespace search {
 
@@ -18,6 +21,48 @@ bool matches(const SC & sc, uint32_t doc) {
     return sc.find(doc, 0) >= 0;
 }
 
+/*
+ * Search contexts able to evaluate the term for a block of 64 documents at a time.
+ * These are single value, so all matches have weight 1.
+ */
+template <typename SC>
+concept BlockMatchable = requires(const SC & sc, uint32_t doc) {
+    { sc.match_block(doc, doc) } -> std::same_as<uint64_t>;
+};
+
+template <typename SC>
+void set_block_hits(const SC & sc, BitVector & result, uint32_t docId, uint32_t endId) {
+    for (; docId < endId; docId += 64) {
+        for (uint64_t bits = sc.match_block(docId, endId); bits != 0; bits &= (bits - 1)) {
+            result.setBit(docId + std::countr_zero(bits));
+        }
+    }
+}
+
+}
+
+template <typename SC>
+uint32_t
+MatchBlockCache::find_next_match(const SC & sc, uint32_t docId, uint32_t endId)
+{
+    while (docId < endId) {
+        if (docId >= _begin && docId < _end) {
+            uint64_t bits = _bits >> (docId - _begin);
+            if (bits != 0) {
+                return docId + std::countr_zero(bits);
+            }
+            docId = _end;
+        } else if (matches(sc, docId)) {
+            // Seeks are often satisfied right away, without evaluating a whole block.
+            return docId;
+        } else {
+            _begin = docId + 1;
+            _end = std::min(endId, _begin + 64);
+            _bits = sc.match_block(_begin, _end);
+            docId = _begin;
+        }
+    }
+    return endId;
 }
 
 template <typename SC>
@@ -30,7 +75,11 @@ AttributeIteratorBase::and_hits_into(const SC & sc, BitVector & result, uint32_t
 template <typename SC>
 void
 AttributeIteratorBase::or_hits_into(const SC & sc, BitVector & result, uint32_t begin_id) const {
-    result.foreach_falsebit([&](uint32_t key) { if ( matches(sc, key)) { result.setBit(key); }}, begin_id);
+    if constexpr (BlockMatchable<SC>) {
+        set_block_hits(sc, result, std::max(begin_id, result.getStartIndex()), result.size());
+    } else {
+        result.foreach_falsebit([&](uint32_t key) { if ( matches(sc, key)) { result.setBit(key); }}, begin_id);
+    }
     result.invalidateCachedCount();
 }
 
@@ -39,9 +88,13 @@ template <typename SC>
 std::unique_ptr<BitVector>
 AttributeIteratorBase::get_hits(const SC & sc, uint32_t begin_id) const {
     BitVector::UP result = BitVector::create(begin_id, getEndId());
-    for (uint32_t docId(std::max(begin_id, getDocId())); docId < getEndId(); docId++) {
-        if (matches(sc, docId)) {
-            result->setBit(docId);
+    if constexpr (BlockMatchable<SC>) {
+        set_block_hits(sc, *result, std::max(begin_id, getDocId()), getEndId());
+    } else {
+        for (uint32_t docId(std::max(begin_id, getDocId())); docId < getEndId(); docId++) {
+            if (matches(sc, docId)) {
+                result->setBit(docId);
+            }
         }
     }
     result->invalidateCachedCount();
@@ -429,11 +482,20 @@ template <typename SC>
 void
 AttributeIteratorStrict<SC>::doSeek(uint32_t docId)
 {
-    for (uint32_t nextId = docId; !isAtEnd(nextId); ++nextId) {
-        if (this->matches(nextId, _weight)) {
+    if constexpr (BlockMatchable<SC>) {
+        uint32_t nextId = isAtEnd(docId) ? docId : _match_block.find_next_match(_concreteSearchCtx, docId, this->getEndId());
+        if (!isAtEnd(nextId)) {
+            _weight = 1;
             setDocId(nextId);
             return;
         }
+    } else {
+        for (uint32_t nextId = docId; !isAtEnd(nextId); ++nextId) {
+            if (this->matches(nextId, _weight)) {
+                setDocId(nextId);
+                return;
+            }
+        }
     }
     setAtEnd();
 }
@@ -442,11 +504,19 @@ template <typename SC>
 void
 FilterAttributeIteratorStrict<SC>::doSeek(uint32_t docId)
 {
-    for (uint32_t nextId = docId; !isAtEnd(nextId); ++nextId) {
-        if (this->matches(nextId)) {
+    if constexpr (BlockMatchable<SC>) {
+        uint32_t nextId = isAtEnd(docId) ? docId : _match_block.find_next_match(_concreteSearchCtx, docId, this->getEndId());
+        if (!isAtEnd(nextId)) {
             setDocId(nextId);
             return;
         }
+    } else {
+        for (uint32_t nextId = docId; !isAtEnd(nextId); ++nextId) {
+            if (this->matches(nextId)) {
+                setDocId(nextId);
+                return;
+            }
+        }
     }
     setAtEnd();
 }
@@ -23,6 +23,7 @@
 #include <vespa/vespalib/util/jsonwriter.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/mmap_file_allocator_factory.h>
+#include <vespa/vespalib/util/placement_memory_allocator_factory.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <thread>
 #include <filesystem>
@@ -73,7 +74,7 @@ make_memory_allocator(const std::string& name, const search::attribute::Config&
     if (allow_paged(config)) {
         return vespalib::alloc::MmapFileAllocatorFactory::instance().make_memory_allocator(name);
     }
-    return {};
+    return vespalib::alloc::PlacementMemoryAllocatorFactory::instance().make_memory_allocator(config.basicType().asString());
 }
 
 bool
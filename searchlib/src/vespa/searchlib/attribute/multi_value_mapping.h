@@ -32,6 +32,7 @@ private:
     using ConstArrayRef = std::span<const ElemT>;
 
     ArrayStore _store;
+    std::unique_ptr<vespalib::datastore::ICompactionContext> _compaction_context;
 public:
     MultiValueMapping(const MultiValueMapping &) = delete;
     MultiValueMapping & operator = (const MultiValueMapping &) = delete;
@@ -65,13 +66,19 @@ public:
     vespalib::MemoryUsage getArrayStoreMemoryUsage() const override;
     vespalib::MemoryUsage update_stat(const CompactionStrategy& compaction_strategy);
     bool consider_compact(const CompactionStrategy &compactionStrategy) {
-        if (_store.consider_compact()) {
+        if (_compaction_context || _store.consider_compact()) {
             compact_worst(compactionStrategy);
             return true;
         }
         return false;
     }
+    /*
+     * Compacts the worst buffers. With a compaction step size in the compaction strategy, at
+     * most that many docs are handled per call and the compaction continues on the following
+     * calls, bounding the time spent in the write thread for each commit.
+     */
     void compact_worst(const CompactionStrategy& compaction_strategy);
+    bool is_compacting() const noexcept { return static_cast<bool>(_compaction_context); }
     bool has_free_lists_enabled() const { return _store.has_free_lists_enabled(); }
     // Set compaction spec. Only used by unit tests.
     void set_compaction_spec(vespalib::datastore::CompactionSpec compaction_spec) noexcept { _store.set_compaction_spec(compaction_spec); }
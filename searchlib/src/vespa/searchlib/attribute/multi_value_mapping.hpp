@@ -13,7 +13,8 @@ MultiValueMapping<ElemT,RefT>::MultiValueMapping(const vespalib::datastore::Arra
                                                   const vespalib::GrowStrategy &gs,
                                                   std::shared_ptr<vespalib::alloc::MemoryAllocator> memory_allocator)
   : MultiValueMappingBase(gs, ArrayStore::getGenerationHolderLocation(_store), memory_allocator),
-    _store(storeCfg, std::move(memory_allocator), ArrayStoreTypeMapper(storeCfg.max_type_id(), array_store_grow_factor, max_buffer_size))
+    _store(storeCfg, std::move(memory_allocator), ArrayStoreTypeMapper(storeCfg.max_type_id(), array_store_grow_factor, max_buffer_size)),
+    _compaction_context()
 {
 }
 
@@ -45,9 +46,14 @@ template <typename ElemT, typename RefT>
 void
 MultiValueMapping<ElemT,RefT>::compact_worst(const CompactionStrategy& compaction_strategy)
 {
-    vespalib::datastore::ICompactionContext::UP compactionContext(_store.compact_worst(compaction_strategy));
-    if (compactionContext) {
-        compactionContext->compact(std::span<AtomicEntryRef>(&_indices[0], _indices.size()));
+    if (!_compaction_context) {
+        _compaction_context = _store.compact_worst(compaction_strategy);
+    }
+    if (_compaction_context) {
+        if (_compaction_context->compact_step(std::span<AtomicEntryRef>(&_indices[0], _indices.size()),
+                                              compaction_strategy.get_compaction_step_size())) {
+            _compaction_context.reset();
+        }
     }
 }
 
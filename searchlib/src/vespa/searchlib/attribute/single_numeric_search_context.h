@@ -4,6 +4,7 @@
 
 #include "numeric_search_context.h"
 #include <vespa/vespalib/util/atomic.h>
+#include <algorithm>
 #include <span>
 
 namespace search::attribute {
@@ -42,6 +43,22 @@ public:
         return this->match(v) ? 0 : -1;
     }
 
+    /*
+     * Evaluates the term for the (at most 64) documents in [docId, end), bit i of the
+     * result is set if docId + i matches. The values are checked without branching, so
+     * whole blocks of the value array are scanned at a time.
+     */
+    uint64_t match_block(DocId docId, DocId end) const {
+        const uint32_t count = std::min(end - docId, 64u);
+        const T* values = _data.data() + docId;
+        uint64_t bits = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            const T v = vespalib::atomic::load_ref_relaxed(values[i]);
+            bits |= uint64_t(this->match(v)) << i;
+        }
+        return bits;
+    }
+
     std::unique_ptr<queryeval::SearchIterator>
     createFilterIterator(fef::TermFieldMatchData* matchData, bool strict) override;
     uint32_t get_committed_docid_limit() const noexcept override;
@@ -123,6 +123,20 @@ bool radix_eof(const T *a, size_t n, ER E)
     return eof;
 }
 
+/**
+ * Comparison sort used for small partitions, only ordering the first topn elements when
+ * fewer than all are needed.
+ **/
+template<typename T, typename GE>
+void comparison_sort(T * a, size_t n, GE E, size_t topn)
+{
+    if (topn < n) {
+        std::partial_sort(a, a + topn, a + n, E);
+    } else {
+        std::sort(a, a + n, E);
+    }
+}
+
 /**
  * radix sort implementation.
  *
@@ -146,7 +160,7 @@ void radix_sort(GR R, GE E, GRE EE, int stackDepth,
     if (((stackDepth > 20) && (radixBits == 0)) || (n < insertSortLevel)) {
         // switch to simpler sort if few elements
         if (n > 1) {
-            std::sort(a, a+n, E);
+            comparison_sort(a, n, E, topn);
         }
         return;
     }
@@ -203,7 +217,7 @@ void radix_sort(GR R, GE E, GRE EE, int stackDepth,
             if (c > insertSortLevel) {
                 radix_sort(R, E, EE, stackDepth + 1, &a[l], c, &radixScratch[l], radixBits, insertSortLevel, topn-sum);
             } else {
-                std::sort(&a[l], &a[l]+c, E);
+                comparison_sort(&a[l], c, E, topn-sum);
             }
             sum += c;
         }
@@ -318,7 +332,7 @@ size_t ShiftBasedRadixSorter<T, GR, GE, SHIFT, continueAfterRadixEnds>::radix_so
                 if (c>insertSortLevel) {
                     sum += ShiftBasedRadixSorter<T, GR, GE, SHIFT - 8, continueAfterRadixEnds>::radix_sort_internal(R, E, &a[l], c, insertSortLevel, topn-sum);
                 } else {
-                    std::sort(a+l, a+l+c, E);
+                    comparison_sort(a+l, c, E, topn-sum);
                     sum += c;
                 }
             }
@@ -334,7 +348,7 @@ size_t ShiftBasedRadixSorter<T, GR, GE, SHIFT, continueAfterRadixEnds>::radix_so
     if (n > insertSortLevel) {
         return radix_sort_internal(R, E, a, n, insertSortLevel, topn);
     } else if (n > 1) {
-        std::sort(a, a + n, E);
+        comparison_sort(a, n, E, topn);
     }
     return n;
 }
@@ -350,8 +364,8 @@ public:
 template<typename A, typename B, typename C>
 class ShiftBasedRadixSorter<A, B, C, -8, true> {
 public:
-    static size_t radix_sort_internal(B, C E, A * v, size_t sz, unsigned int, size_t) {
-        std::sort(v, v + sz, E);
+    static size_t radix_sort_internal(B, C E, A * v, size_t sz, unsigned int, size_t topn) {
+        comparison_sort(v, sz, E, topn);
         return sz;
     }
 };
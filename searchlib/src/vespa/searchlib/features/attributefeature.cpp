@@ -6,6 +6,7 @@
 #include "constant_tensor_executor.h"
 #include "dense_tensor_attribute_executor.h"
 #include "direct_tensor_attribute_executor.h"
+#include "streamed_tensor_attribute_executor.h"
 #include "tensor_attribute_executor.h"
 
 #include <vespa/searchcommon/common/undefinedvalues.h>
@@ -434,7 +435,7 @@ createAttributeExecutor(uint32_t numOutputs, const IAttributeVector *attribute,
 
 fef::FeatureExecutor &
 createTensorAttributeExecutor(const IAttributeVector *attribute, const std::string &attrName,
-                              const ValueType &tensorType,
+                              const ValueType &tensorType, bool use_streamed_tensor,
                               vespalib::Stash &stash)
 {
     if (attribute == nullptr) {
@@ -469,6 +470,9 @@ createTensorAttributeExecutor(const IAttributeVector *attribute, const std::stri
     if (tensorAttribute->supports_get_tensor_ref()) {
         return stash.create<DirectTensorAttributeExecutor>(*tensorAttribute);
     }
+    if (use_streamed_tensor && tensorAttribute->supports_get_serialized_tensor_ref()) {
+        return stash.create<StreamedTensorAttributeExecutor>(*tensorAttribute);
+    }
     return stash.create<TensorAttributeExecutor>(*tensorAttribute);
 }
 
@@ -486,7 +490,8 @@ AttributeBlueprint::AttributeBlueprint() :
     _attrKey(),
     _extra(),
     _tensorType(ValueType::double_type()),
-    _numOutputs(0)
+    _numOutputs(0),
+    _use_streamed_tensor(false)
 {
 }
 
@@ -532,6 +537,7 @@ AttributeBlueprint::setup(const fef::IIndexEnvironment & env,
         describeOutput("count", "Returns the number of elements in this array or weighted set attribute.");
         _numOutputs = 4;
     }
+    _use_streamed_tensor = fef::indexproperties::eval::UseStreamedTensorAttributes::check(env.getProperties());
     return !_tensorType.is_error();
 }
 
@@ -552,7 +558,7 @@ AttributeBlueprint::createExecutor(const fef::IQueryEnvironment &env, vespalib::
 {
     const IAttributeVector * attribute = lookupAttribute(_attrKey, _attrName, env);
     if (_tensorType.has_dimensions()) {
-        return createTensorAttributeExecutor(attribute, _attrName, _tensorType, stash);
+        return createTensorAttributeExecutor(attribute, _attrName, _tensorType, _use_streamed_tensor, stash);
     } else {
         return createAttributeExecutor(_numOutputs, attribute, _attrName, _extra, stash);
     }
@@ -20,6 +20,7 @@ private:
     std::string          _extra;    // the index or key
     vespalib::eval::ValueType _tensorType;
     uint8_t                   _numOutputs;
+    bool                      _use_streamed_tensor;
 
 
 public:
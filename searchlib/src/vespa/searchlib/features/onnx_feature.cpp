@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "onnx_feature.h"
+#include <vespa/searchlib/fef/indexproperties.h>
 #include <vespa/searchlib/fef/properties.h>
 #include <vespa/searchlib/fef/onnx_model.h>
 #include <vespa/searchlib/fef/featureexecutor.h>
@@ -8,6 +9,7 @@
 #include <vespa/eval/eval/tensor_spec.h>
 #include <vespa/eval/eval/fast_value.h>
 #include <vespa/eval/eval/value_codec.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/stash.h>
 #include <vespa/vespalib/util/issue.h>
@@ -101,12 +103,101 @@ public:
     }
 };
 
+/**
+ * Feature executor that evaluates an onnx model for several documents
+ * at once by stacking their inputs along the batch dimension of the
+ * model. Documents not part of the current batch are evaluated one by
+ * one.
+ */
+class BatchOnnxFeatureExecutor : public FeatureExecutor
+{
+private:
+    Onnx::EvalContext                      _eval_context;
+    Onnx::BatchEvalContext                 _batch_context;
+    std::vector<uint32_t>                  _pending;
+    vespalib::hash_map<uint32_t, uint32_t> _batch_docs; // docid -> index of first result
+    std::vector<Value::UP>                 _batch_results;
+
+    void flush() {
+        if (_pending.empty()) {
+            return;
+        }
+        try {
+            _batch_context.eval(_pending.size());
+            for (size_t slot = 0; slot < _pending.size(); ++slot) {
+                _batch_docs[_pending[slot]] = _batch_results.size();
+                for (size_t i = 0; i < _batch_context.num_results(); ++i) {
+                    _batch_results.push_back(_batch_context.extract_result(i, slot));
+                }
+            }
+        } catch (const Ort::Exception &ex) {
+            Issue::report("onnx model batch evaluation failed: %s", ex.what());
+        }
+        _pending.clear();
+    }
+    void handle_batch_begin() override {
+        _pending.clear();
+        _batch_docs.clear();
+        _batch_results.clear();
+    }
+    void handle_batch_add(uint32_t docid) override {
+        size_t slot = _pending.size();
+        for (size_t i = 0; i < _batch_context.num_params(); ++i) {
+            _batch_context.bind_param(i, slot, inputs().get_object(i).get());
+        }
+        _pending.push_back(docid);
+        if (_pending.size() == _batch_context.max_batch_size()) {
+            flush();
+        }
+    }
+    void handle_batch_end() override {
+        flush();
+    }
+public:
+    BatchOnnxFeatureExecutor(const Onnx &model, const Onnx::WireInfo &wire_info, size_t batch_size)
+        : _eval_context(model, wire_info),
+          _batch_context(model, wire_info, batch_size),
+          _pending(),
+          _batch_docs(),
+          _batch_results()
+    {
+        _pending.reserve(batch_size);
+    }
+    ~BatchOnnxFeatureExecutor() override;
+    bool isPure() override { return true; }
+    bool supports_batch() override { return true; }
+    void execute(uint32_t docid) override {
+        auto pos = _batch_docs.find(docid);
+        if (pos != _batch_docs.end()) {
+            for (size_t i = 0; i < _batch_context.num_results(); ++i) {
+                outputs().set_object(i, *_batch_results[pos->second + i]);
+            }
+            return;
+        }
+        for (size_t i = 0; i < _eval_context.num_params(); ++i) {
+            _eval_context.bind_param(i, inputs().get_object(i).get());
+        }
+        try {
+            _eval_context.eval();
+        } catch (const Ort::Exception &ex) {
+            Issue::report("onnx model evaluation failed: %s", ex.what());
+            _eval_context.clear_results();
+        }
+        for (size_t i = 0; i < _eval_context.num_results(); ++i) {
+            outputs().set_object(i, _eval_context.get_result(i));
+        }
+    }
+};
+
+BatchOnnxFeatureExecutor::~BatchOnnxFeatureExecutor() = default;
+
 OnnxBlueprint::OnnxBlueprint(std::string_view baseName)
     : Blueprint(baseName),
       _cache_token(),
       _debug_model(),
       _model(nullptr),
-      _wire_info()
+      _wire_info(),
+      _batch_size(0)
 {
     assert((baseName == "onnx") || (baseName == "onnxModel"));
 }
@@ -165,6 +256,15 @@ OnnxBlueprint::setup(const IIndexEnvironment &env,
         describeOutput(output_name.value(), "output from onnx model", FeatureType::object(output_type));
     }
     _wire_info = planner.get_wire_info(*_model);
+    uint32_t batch_size = fef::indexproperties::eval::OnnxBatchSize::lookup(env.getProperties());
+    if (batch_size > 1) {
+        if (planner.can_batch(*_model)) {
+            _batch_size = batch_size;
+        } else {
+            LOG(debug, "onnx model '%s' has no batch dimension bound to size 1, it will not be evaluated in batches",
+                model_cfg->name().c_str());
+        }
+    }
     if (model_cfg->dry_run_on_setup()) {
         auto error_msg = my_dry_run(*_model, _wire_info);
         if (!error_msg.empty()) {
@@ -180,6 +280,9 @@ FeatureExecutor &
 OnnxBlueprint::createExecutor(const IQueryEnvironment &, Stash &stash) const
 {
     assert(_model != nullptr);
+    if (_batch_size > 1) {
+        return stash.create<BatchOnnxFeatureExecutor>(*_model, _wire_info, _batch_size);
+    }
     return stash.create<OnnxFeatureExecutor>(*_model, _wire_info);
 }
 
@@ -19,6 +19,7 @@ private:
     std::unique_ptr<Onnx> _debug_model;
     const Onnx *_model;
     Onnx::WireInfo _wire_info;
+    uint32_t _batch_size;
 public:
     OnnxBlueprint(std::string_view baseName);
     ~OnnxBlueprint() override;
@@ -7,6 +7,7 @@
 #include <vespa/searchlib/features/rankingexpression/feature_name_extractor.h>
 #include <vespa/eval/eval/param_usage.h>
 #include <vespa/eval/eval/fast_value.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/util/stringfmt.h>
 
 #include <vespa/log/log.h>
@@ -58,6 +59,37 @@ public:
     void execute(uint32_t docId) override;
 };
 
+/**
+ * Implements the executor for fast forest gbdt evaluation of several
+ * documents at once. Documents not part of the current batch are
+ * evaluated one by one.
+ **/
+class BatchFastForestExecutor : public fef::FeatureExecutor
+{
+private:
+    const FastForest                     &_forest;
+    FastForest::Context::UP               _ctx;
+    size_t                                _batch_size;
+    std::vector<float>                    _params;       // [doc][param] for pending documents
+    std::vector<uint32_t>                 _pending;
+    std::vector<double>                   _results;
+    vespalib::hash_map<uint32_t, double>  _batch_results;
+
+    float *param_space(size_t doc) { return &_params[doc * _forest.num_params()]; }
+    void fetch_params(float *dst);
+    void flush();
+    void handle_batch_begin() override;
+    void handle_batch_add(uint32_t docid) override;
+    void handle_batch_end() override;
+
+public:
+    BatchFastForestExecutor(const FastForest &forest, size_t batch_size);
+    ~BatchFastForestExecutor() override;
+    bool isPure() override { return true; }
+    bool supports_batch() override { return true; }
+    void execute(uint32_t docId) override;
+};
+
 //-----------------------------------------------------------------------------
 
 /**
@@ -169,6 +201,78 @@ FastForestExecutor::execute(uint32_t)
     outputs().set_number(0, _forest.eval(*_ctx, &_params[0]));
 }
 
+BatchFastForestExecutor::BatchFastForestExecutor(const FastForest &forest, size_t batch_size)
+    : _forest(forest),
+      _ctx(_forest.create_context()),
+      _batch_size(batch_size),
+      _params((batch_size + 1) * forest.num_params(), 0.0),
+      _pending(),
+      _results(batch_size, 0.0),
+      _batch_results()
+{
+    _pending.reserve(batch_size);
+}
+
+BatchFastForestExecutor::~BatchFastForestExecutor() = default;
+
+void
+BatchFastForestExecutor::fetch_params(float *dst)
+{
+    for (size_t i = 0; i < _forest.num_params(); ++i) {
+        dst[i] = inputs().get_number(i);
+    }
+}
+
+void
+BatchFastForestExecutor::flush()
+{
+    if (_pending.empty()) {
+        return;
+    }
+    _forest.eval_batch(*_ctx, param_space(0), _pending.size(), &_results[0]);
+    for (size_t i = 0; i < _pending.size(); ++i) {
+        _batch_results[_pending[i]] = _results[i];
+    }
+    _pending.clear();
+}
+
+void
+BatchFastForestExecutor::handle_batch_begin()
+{
+    _pending.clear();
+    _batch_results.clear();
+}
+
+void
+BatchFastForestExecutor::handle_batch_add(uint32_t docid)
+{
+    fetch_params(param_space(_pending.size()));
+    _pending.push_back(docid);
+    if (_pending.size() == _batch_size) {
+        flush();
+    }
+}
+
+void
+BatchFastForestExecutor::handle_batch_end()
+{
+    flush();
+}
+
+void
+BatchFastForestExecutor::execute(uint32_t docId)
+{
+    auto pos = _batch_results.find(docId);
+    if (pos != _batch_results.end()) {
+        outputs().set_number(0, pos->second);
+        return;
+    }
+    // the last slot is never used for pending batch documents
+    float *params = param_space(_batch_size);
+    fetch_params(params);
+    outputs().set_number(0, _forest.eval(*_ctx, params));
+}
+
 //-----------------------------------------------------------------------------
 
 CompiledRankingExpressionExecutor::CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function)
@@ -256,6 +360,7 @@ RankingExpressionBlueprint::RankingExpressionBlueprint(rankingexpression::Expres
       _expression_replacer(std::move(replacer)),
       _intrinsic_expression(),
       _fast_forest(),
+      _fast_forest_batch_size(0),
       _interpreted_function(),
       _compile_token(),
       _input_is_object(),
@@ -350,6 +455,9 @@ RankingExpressionBlueprint::setup(const fef::IIndexEnvironment &env,
             // fast forest evaluation is a possible replacement for compiled tree models
             if (fef::indexproperties::eval::UseFastForest::check(env.getProperties())) {
                 _fast_forest = FastForest::try_convert(*rank_function);
+                if (_fast_forest) {
+                    _fast_forest_batch_size = fef::indexproperties::eval::FastForestBatchSize::lookup(env.getProperties());
+                }
             }
             if (!_fast_forest) {
                 bool suggest_lazy = CompiledFunction::should_use_lazy_params(*rank_function);
@@ -400,6 +508,9 @@ RankingExpressionBlueprint::createExecutor(const fef::IQueryEnvironment &env, ve
             return stash.create<InterpretedRankingExpressionExecutor>(*_interpreted_function, input_is_object);
         }
     }
+    if (_fast_forest && (_fast_forest_batch_size > 1)) {
+        return stash.create<BatchFastForestExecutor>(*_fast_forest, _fast_forest_batch_size);
+    }
     if (_fast_forest) {
         std::span<float> param_space = stash.create_array<float>(_input_is_object.size(), 0.0);
         return stash.create<FastForestExecutor>(param_space, *_fast_forest);
@@ -0,0 +1,33 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "streamed_tensor_attribute_executor.h"
+#include <vespa/searchlib/tensor/i_tensor_attribute.h>
+#include <vespa/searchlib/tensor/serialized_tensor_ref.h>
+
+namespace search::features {
+
+StreamedTensorAttributeExecutor::
+StreamedTensorAttributeExecutor(const ITensorAttribute &attribute)
+    : _attribute(attribute),
+      _empty_tensor(attribute.getEmptyTensor()),
+      _view()
+{
+}
+
+StreamedTensorAttributeExecutor::~StreamedTensorAttributeExecutor() = default;
+
+void
+StreamedTensorAttributeExecutor::execute(uint32_t docId)
+{
+    auto ref = _attribute.get_serialized_tensor_ref(docId);
+    const auto &vectors = ref.get_vectors();
+    if (vectors.subspaces() == 0) {
+        outputs().set_object(0, *_empty_tensor);
+        return;
+    }
+    _view.emplace(_attribute.getTensorType(), ref.get_num_mapped_dimensions(),
+                  vectors.all_cells(), vectors.subspaces(), ref.get_all_labels());
+    outputs().set_object(0, *_view);
+}
+
+}
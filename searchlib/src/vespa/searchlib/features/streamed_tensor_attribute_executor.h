@@ -0,0 +1,34 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/fef/featureexecutor.h>
+#include <vespa/eval/streamed/streamed_value_view.h>
+#include <optional>
+
+namespace search::tensor { class ITensorAttribute; }
+namespace search::features {
+
+/**
+ * Executor for tensor attributes storing tensors in a tensor buffer
+ * store (see ITensorAttribute::get_serialized_tensor_ref). The stored
+ * labels and cells are wrapped in a StreamedValueView without copying
+ * or allocating anything. This avoids building a hash index for the
+ * labels of each document, at the cost of slower lookups of single
+ * subspaces; a good fit for tensors that are iterated in full (like
+ * multi-vector tensors used for late interaction ranking).
+ **/
+class StreamedTensorAttributeExecutor : public fef::FeatureExecutor
+{
+public:
+    using ITensorAttribute = search::tensor::ITensorAttribute;
+    StreamedTensorAttributeExecutor(const ITensorAttribute &attribute);
+    ~StreamedTensorAttributeExecutor() override;
+    void execute(uint32_t docId) override;
+private:
+    const ITensorAttribute                           &_attribute;
+    std::unique_ptr<vespalib::eval::Value>            _empty_tensor;
+    std::optional<vespalib::eval::StreamedValueView>  _view;
+};
+
+}
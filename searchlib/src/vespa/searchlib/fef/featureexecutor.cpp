@@ -20,6 +20,12 @@ FeatureExecutor::isPure()
     return false;
 }
 
+bool
+FeatureExecutor::supports_batch()
+{
+    return false;
+}
+
 void
 FeatureExecutor::handle_bind_inputs(std::span<const LazyValue>)
 {
@@ -35,6 +41,21 @@ FeatureExecutor::handle_bind_match_data(const MatchData &)
 {
 }
 
+void
+FeatureExecutor::handle_batch_begin()
+{
+}
+
+void
+FeatureExecutor::handle_batch_add(uint32_t)
+{
+}
+
+void
+FeatureExecutor::handle_batch_end()
+{
+}
+
 void
 FeatureExecutor::bind_inputs(std::span<const LazyValue> inputs)
 {
@@ -98,6 +98,9 @@ protected:
     virtual void handle_bind_inputs(std::span<const LazyValue> inputs);
     virtual void handle_bind_outputs(std::span<NumberOrObject> outputs);
     virtual void handle_bind_match_data(const MatchData &md);
+    virtual void handle_batch_begin();
+    virtual void handle_batch_add(uint32_t docid);
+    virtual void handle_batch_end();
 
     /**
      * Execute this feature executor for the given document.
@@ -148,6 +151,28 @@ public:
      **/
     virtual bool isPure();
 
+    /**
+     * Check if this feature executor is able to evaluate several
+     * documents at once. Such executors may be given the documents
+     * to be evaluated up front: batch_begin, then batch_add for each
+     * document (with its match data unpacked), then batch_end. The
+     * executor may then do the actual work for all of them in one go
+     * and use the results when it is later executed for those
+     * documents. Documents not added to the current batch must still
+     * be evaluated as usual. This method is implemented to return
+     * false by default.
+     *
+     * @return true if this feature executor supports batch evaluation
+     **/
+    virtual bool supports_batch();
+    void batch_begin() { handle_batch_begin(); }
+    void batch_add(uint32_t docid) {
+        _inputs.set_docid(docid);
+        handle_batch_add(docid);
+        _inputs.set_docid(-1);
+    }
+    void batch_end() { handle_batch_end(); }
+
     /**
      * Make sure this executor has been executed for the given
      * document.
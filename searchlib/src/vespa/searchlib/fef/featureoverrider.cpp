@@ -30,6 +30,30 @@ FeatureOverrider::isPure()
     return _executor.isPure();
 }
 
+bool
+FeatureOverrider::supports_batch()
+{
+    return _executor.supports_batch();
+}
+
+void
+FeatureOverrider::handle_batch_begin()
+{
+    _executor.batch_begin();
+}
+
+void
+FeatureOverrider::handle_batch_add(uint32_t docid)
+{
+    _executor.batch_add(docid);
+}
+
+void
+FeatureOverrider::handle_batch_end()
+{
+    _executor.batch_end();
+}
+
 void
 FeatureOverrider::execute(uint32_t docId)
 {
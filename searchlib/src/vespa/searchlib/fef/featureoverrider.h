@@ -26,12 +26,16 @@ private:
     virtual void handle_bind_match_data(const MatchData &md) override;
     virtual void handle_bind_inputs(std::span<const LazyValue> inputs) override;
     virtual void handle_bind_outputs(std::span<NumberOrObject> outputs) override;
+    void handle_batch_begin() override;
+    void handle_batch_add(uint32_t docid) override;
+    void handle_batch_end() override;
 
 public:
     FeatureOverrider(const FeatureOverrider &) = delete;
     FeatureOverrider &operator=(const FeatureOverrider &) = delete;
     FeatureOverrider(FeatureExecutor &executor, uint32_t outputIdx, feature_t number, Value::UP object);
     bool isPure() override;
+    bool supports_batch() override;
     void execute(uint32_t docId) override;
 };
 
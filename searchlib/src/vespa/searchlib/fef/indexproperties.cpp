@@ -100,6 +100,22 @@ const std::string UseFastForest::NAME("vespa.eval.use_fast_forest");
 const bool UseFastForest::DEFAULT_VALUE(false);
 bool UseFastForest::check(const Properties &props) { return lookupBool(props, NAME, DEFAULT_VALUE); }
 
+const std::string FastForestBatchSize::NAME("vespa.eval.fast_forest_batch_size");
+const uint32_t FastForestBatchSize::DEFAULT_VALUE(0);
+uint32_t FastForestBatchSize::lookup(const Properties &props) { return lookupUint32(props, NAME, DEFAULT_VALUE); }
+
+const std::string OnnxBatchSize::NAME("vespa.eval.onnx_batch_size");
+const uint32_t OnnxBatchSize::DEFAULT_VALUE(0);
+uint32_t OnnxBatchSize::lookup(const Properties &props) { return lookupUint32(props, NAME, DEFAULT_VALUE); }
+
+const std::string UseStreamedTensorAttributes::NAME("vespa.eval.use_streamed_tensor_attributes");
+const bool UseStreamedTensorAttributes::DEFAULT_VALUE(false);
+bool UseStreamedTensorAttributes::check(const Properties &props) { return lookupBool(props, NAME, DEFAULT_VALUE); }
+
+const std::string PureFeatureCacheSize::NAME("vespa.eval.pure_feature_cache_size");
+const uint32_t PureFeatureCacheSize::DEFAULT_VALUE(0);
+uint32_t PureFeatureCacheSize::lookup(const Properties &props) { return lookupUint32(props, NAME, DEFAULT_VALUE); }
+
 } // namespace eval
 
 namespace rank {
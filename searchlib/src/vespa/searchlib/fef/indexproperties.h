@@ -36,6 +36,43 @@ struct UseFastForest {
     static bool check(const Properties &props);
 };
 
+// max number of documents evaluated together by fast-forest gbdt
+// models (see UseFastForest); 0 or 1 disables batching. affects rank
+struct FastForestBatchSize {
+    static const std::string NAME;
+    static const uint32_t DEFAULT_VALUE;
+    static uint32_t lookup(const Properties &props);
+};
+
+// max number of documents evaluated together by onnx models with a
+// leading batch dimension; 0 or 1 disables batching. affects rank
+struct OnnxBatchSize {
+    static const std::string NAME;
+    static const uint32_t DEFAULT_VALUE;
+    static uint32_t lookup(const Properties &props);
+};
+
+// let the attribute feature wrap tensors stored in tensor buffer
+// stores in a StreamedValueView instead of a FastValueView; avoids
+// building a label hash index per document, but makes lookups of
+// single subspaces slower. affects rank/summary/dump
+struct UseStreamedTensorAttributes {
+    static const std::string NAME;
+    static const bool DEFAULT_VALUE;
+    static bool check(const Properties &props);
+};
+
+// max number of distinct input value combinations remembered for
+// each pure non-constant number feature in the rank program. Such
+// features are only calculated once for each combination, at the
+// cost of always calculating all their inputs. 0 disables. affects
+// rank/summary/dump
+struct PureFeatureCacheSize {
+    static const std::string NAME;
+    static const uint32_t DEFAULT_VALUE;
+    static uint32_t lookup(const Properties &props);
+};
+
 } // namespace eval
 
 namespace rank {
@@ -0,0 +1,98 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "memoizing_executor.h"
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <bit>
+
+namespace search::fef {
+
+size_t
+MemoizingExecutor::KeyHash::operator()(const std::vector<uint64_t> &key) const noexcept
+{
+    return vespalib::hashValue(key.data(), key.size() * sizeof(uint64_t));
+}
+
+void
+MemoizingExecutor::handle_bind_match_data(const MatchData &md)
+{
+    _executor.bind_match_data(md);
+}
+
+void
+MemoizingExecutor::handle_bind_inputs(std::span<const LazyValue> inputs)
+{
+    _executor.bind_inputs(inputs);
+    _key_inputs.clear();
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (!inputs[i].is_const()) {
+            _key_inputs.push_back(i);
+        }
+    }
+    _key.resize(_key_inputs.size());
+}
+
+void
+MemoizingExecutor::handle_bind_outputs(std::span<NumberOrObject> outputs)
+{
+    _executor.bind_outputs(outputs);
+    _last_values.resize(outputs.size());
+}
+
+MemoizingExecutor::MemoizingExecutor(FeatureExecutor &executor, size_t max_entries)
+    : _executor(executor),
+      _max_entries(max_entries),
+      _key_inputs(),
+      _key(),
+      _cache(),
+      _values(),
+      _last_values(),
+      _last_docid(-1),
+      _stats{0, 0}
+{
+}
+
+MemoizingExecutor::~MemoizingExecutor() = default;
+
+bool
+MemoizingExecutor::isPure()
+{
+    return _executor.isPure();
+}
+
+void
+MemoizingExecutor::execute(uint32_t docId)
+{
+    for (size_t i = 0; i < _key_inputs.size(); ++i) {
+        // compare bit patterns to tell apart 0.0/-0.0 and match NaN
+        _key[i] = std::bit_cast<uint64_t>(inputs().get_number(_key_inputs[i]));
+    }
+    size_t num_outputs = outputs().size();
+    auto pos = _cache.find(_key);
+    if (pos != _cache.end()) {
+        ++_stats.hits;
+        for (size_t i = 0; i < num_outputs; ++i) {
+            outputs().set_number(i, _values[pos->second + i]);
+        }
+        return;
+    }
+    ++_stats.misses;
+    if (docId == _last_docid) {
+        // inner executor will not run again for the same document,
+        // but the outputs may have been overwritten by cached values
+        for (size_t i = 0; i < num_outputs; ++i) {
+            outputs().set_number(i, _last_values[i]);
+        }
+    } else {
+        _executor.lazy_execute(docId);
+        _last_docid = docId;
+        for (size_t i = 0; i < num_outputs; ++i) {
+            _last_values[i] = outputs().get_number(i);
+        }
+    }
+    if (_cache.size() < _max_entries) {
+        _cache[_key] = _values.size();
+        _values.insert(_values.end(), _last_values.begin(), _last_values.end());
+    }
+}
+
+}
@@ -0,0 +1,60 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "featureexecutor.h"
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vector>
+
+namespace search::fef {
+
+/**
+ * A decorator wrapping a single pure Feature Executor with number
+ * inputs and outputs, remembering its output values for each
+ * distinct combination of (non-constant) input values. The inner
+ * executor is only executed for input values not seen before. This
+ * pays off for features calculated from low-cardinality inputs
+ * (like attributes with few unique values), but note that all inputs
+ * must be calculated for each document to look up the outputs. At
+ * most 'max_entries' input combinations are remembered.
+ **/
+class MemoizingExecutor : public FeatureExecutor
+{
+public:
+    struct Stats {
+        size_t hits;
+        size_t misses;
+    };
+
+private:
+    struct KeyHash {
+        size_t operator()(const std::vector<uint64_t> &key) const noexcept;
+    };
+    using Cache = vespalib::hash_map<std::vector<uint64_t>, uint32_t, KeyHash>;
+
+    FeatureExecutor       &_executor;
+    size_t                 _max_entries;
+    std::vector<uint32_t>  _key_inputs;  // indexes of non-constant inputs
+    std::vector<uint64_t>  _key;         // input values (bit patterns) for current document
+    Cache                  _cache;       // input values -> offset of output values
+    std::vector<feature_t> _values;
+    std::vector<feature_t> _last_values; // output values from last execution of inner executor
+    uint32_t               _last_docid;
+    Stats                  _stats;
+
+    void handle_bind_match_data(const MatchData &md) override;
+    void handle_bind_inputs(std::span<const LazyValue> inputs) override;
+    void handle_bind_outputs(std::span<NumberOrObject> outputs) override;
+
+public:
+    MemoizingExecutor(const MemoizingExecutor &) = delete;
+    MemoizingExecutor &operator=(const MemoizingExecutor &) = delete;
+    MemoizingExecutor(FeatureExecutor &executor, size_t max_entries);
+    ~MemoizingExecutor() override;
+    bool isPure() override;
+    void execute(uint32_t docId) override;
+    size_t num_entries() const { return _cache.size(); }
+    const Stats &get_stats() const { return _stats; }
+};
+
+}
@@ -3,6 +3,10 @@
 #include "rank_program.h"
 #include "featureoverrider.h"
 #include "blueprint.h"
+#include "iindexenvironment.h"
+#include "indexproperties.h"
+#include "iqueryenvironment.h"
+#include "memoizing_executor.h"
 #include <vespa/vespalib/locale/c.h>
 #include <vespa/eval/eval/fast_value.h>
 #include <vespa/eval/eval/value_codec.h>
@@ -123,6 +127,20 @@ struct ProfiledExecutor : FeatureExecutor {
     bool isPure() override {
         return executor.isPure();
     }
+    bool supports_batch() override {
+        return executor.supports_batch();
+    }
+    void handle_batch_begin() override {
+        executor.batch_begin();
+    }
+    void handle_batch_add(uint32_t docid) override {
+        executor.batch_add(docid);
+    }
+    void handle_batch_end() override {
+        profiler.start(self);
+        executor.batch_end();
+        profiler.complete();
+    }
     void execute(uint32_t docId) override {
         profiler.start(self);
         executor.lazy_execute(docId);
@@ -130,6 +148,20 @@ struct ProfiledExecutor : FeatureExecutor {
     }
 };
 
+bool has_only_numbers(const BlueprintResolver::ExecutorSpecList &specs, uint32_t idx) {
+    for (const auto &ref: specs[idx].inputs) {
+        if (specs[ref.executor].output_types[ref.output].is_object()) {
+            return false;
+        }
+    }
+    for (const auto &type: specs[idx].output_types) {
+        if (type.is_object()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 class StashSelector {
 private:
     Stash &_primary;
@@ -223,7 +255,9 @@ RankProgram::RankProgram(BlueprintResolver::SP resolver)
       _cold_stash(),
       _executors(),
       _unboxed_seeds(),
-      _is_const()
+      _is_const(),
+      _batch_executors(),
+      _memoizing_executors()
 {
 }
 
@@ -240,6 +274,7 @@ RankProgram::setup(const MatchData &md,
     std::vector<Override> overrides = prepare_overrides(specs, _resolver->getFeatureMap(), featureOverrides);
     auto override = overrides.begin();
     auto override_end = overrides.end();
+    size_t cache_size = indexproperties::eval::PureFeatureCacheSize::lookup(queryEnv.getIndexEnvironment().getProperties());
 
     _executors.reserve(specs.size());
     _is_const.resize(specs.size()*2); // Reserve space in hashmap for executors to be const
@@ -269,6 +304,11 @@ RankProgram::setup(const MatchData &md,
             FeatureExecutor *tmp = executor;
             executor = &(stash.get().create<FeatureOverrider>(*tmp, override->ref.output, override->number, std::move(override->object)));
         }
+        if ((cache_size > 0) && !is_const && executor->isPure() && !executor->supports_batch() && has_only_numbers(specs, i)) {
+            auto &memo = stash.get().create<MemoizingExecutor>(*executor, cache_size);
+            _memoizing_executors.push_back(&memo);
+            executor = &memo;
+        }
         if (profiler) {
             FeatureExecutor *tmp = executor;
             executor = &(stash.get().create<ProfiledExecutor>(*profiler, *tmp, specs[i].blueprint->getName()));
@@ -279,6 +319,8 @@ RankProgram::setup(const MatchData &md,
         _executors.push_back(executor);
         if (is_const) {
             run_const(executor);
+        } else if (executor->supports_batch()) {
+            _batch_executors.push_back(executor);
         }
     }
     for (const auto &seed_entry: _resolver->getSeedMap()) {
@@ -306,6 +348,42 @@ RankProgram::setup(const MatchData &md,
     }
 }
 
+void
+RankProgram::begin_batch()
+{
+    for (FeatureExecutor *executor: _batch_executors) {
+        executor->batch_begin();
+    }
+}
+
+void
+RankProgram::add_to_batch(uint32_t docid)
+{
+    for (FeatureExecutor *executor: _batch_executors) {
+        executor->batch_add(docid);
+    }
+}
+
+void
+RankProgram::end_batch()
+{
+    for (FeatureExecutor *executor: _batch_executors) {
+        executor->batch_end();
+    }
+}
+
+RankProgram::MemoizationStats
+RankProgram::get_memoization_stats() const
+{
+    MemoizationStats stats{_memoizing_executors.size(), 0, 0, 0};
+    for (const MemoizingExecutor *executor: _memoizing_executors) {
+        stats.num_entries += executor->num_entries();
+        stats.hits += executor->get_stats().hits;
+        stats.misses += executor->get_stats().misses;
+    }
+    return stats;
+}
+
 FeatureResolver
 RankProgram::get_seeds(bool unbox_seeds) const
 {
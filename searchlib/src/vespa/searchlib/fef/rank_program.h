@@ -16,6 +16,7 @@ namespace vespalib { class ExecutionProfiler; }
 namespace search::fef {
 
 class IQueryEnvironment;
+class MemoizingExecutor;
 
 /**
  * A rank program is able to lazily calculate a set of feature
@@ -40,6 +41,8 @@ private:
     std::vector<FeatureExecutor *>   _executors;
     MappedValues                     _unboxed_seeds;
     ValueSet                         _is_const;
+    std::vector<FeatureExecutor *>   _batch_executors;
+    std::vector<MemoizingExecutor *> _memoizing_executors;
 
     bool check_const(const NumberOrObject *value) const { return (_is_const.count(value) == 1); }
     bool check_const(FeatureExecutor *executor, const std::vector<BlueprintResolver::FeatureRef> &inputs) const;
@@ -49,6 +52,19 @@ private:
 
 public:
     using UP = std::unique_ptr<RankProgram>;
+
+    // aggregated cache statistics for memoized pure features
+    struct MemoizationStats {
+        size_t num_features;
+        size_t num_entries;
+        size_t hits;
+        size_t misses;
+        double hit_rate() const {
+            size_t lookups = hits + misses;
+            return (lookups == 0) ? 0.0 : (double(hits) / lookups);
+        }
+    };
+
     RankProgram(const RankProgram &) = delete;
     RankProgram &operator=(const RankProgram &) = delete;
 
@@ -73,6 +89,27 @@ public:
                const Properties &featureOverrides = Properties(),
                vespalib::ExecutionProfiler *profiler = nullptr);
 
+    /**
+     * Documents to be evaluated may be given to executors able to
+     * evaluate several documents at once (see
+     * FeatureExecutor::supports_batch) before their values are
+     * resolved: call begin_batch, then add_to_batch for each document
+     * (with match data unpacked for it), then end_batch.
+     **/
+    bool has_batch_executors() const { return !_batch_executors.empty(); }
+    void begin_batch();
+    void add_to_batch(uint32_t docid);
+    void end_batch();
+
+    /**
+     * Pure non-constant features with only number inputs and outputs
+     * may be memoized (see indexproperties::eval::PureFeatureCacheSize);
+     * calculated once for each distinct combination of input values
+     * instead of once for each document. Returns the cache statistics
+     * for this rank program.
+     **/
+    MemoizationStats get_memoization_stats() const;
+
     /**
      * Obtain the names and storage locations of all seed features for
      * this rank program. Programs for ranking phases will only have a
@@ -0,0 +1,202 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/objects/deserializer.h>
+#include <vespa/vespalib/objects/serializer.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace search {
+
+/**
+ * KLL quantile sketch (Karnin, Lang, Liberty) for doubles. Values are
+ * kept in a hierarchy of compactors where an item at level h represents
+ * 2^h inputs. When the sketch exceeds its capacity, the lowest full
+ * compactor is sorted and every other item is promoted to the next
+ * level. The rank error is about 1.7 / k, independent of the number of
+ * values seen, and sketches from different nodes can be merged.
+ *
+ * The choice of which half to promote alternates between compactions
+ * instead of being random, which keeps the sketch reproducible.
+ */
+class KllSketch {
+public:
+    static constexpr uint32_t DEFAULT_K = 200;
+
+    explicit KllSketch(uint32_t k = DEFAULT_K)
+        : _k(std::max(k, MIN_K)), _count(0), _size(0), _capacity(0), _compactions(0), _levels(1)
+    {
+        _capacity = calcCapacity();
+    }
+
+    void aggregate(double value);
+    void merge(const KllSketch &other);
+    void serialize(vespalib::Serializer &os) const;
+    void deserialize(vespalib::Deserializer &is);
+
+    // Returns the estimated value at the given quantile in [0, 1], or NaN if empty.
+    double quantile(double q) const;
+
+    uint32_t getK() const { return _k; }
+    uint64_t getCount() const { return _count; }
+    // Number of values retained by the sketch.
+    size_t getSize() const { return _size; }
+
+    bool operator==(const KllSketch &other) const {
+        return (_k == other._k) && (_count == other._count) && (_levels == other._levels);
+    }
+
+private:
+    static constexpr uint32_t MIN_K = 8;
+    static constexpr double CAPACITY_DECAY = 2.0 / 3.0;
+
+    uint32_t levelCapacity(size_t level) const;
+    size_t calcCapacity() const;
+    void compress();
+    void compact(size_t level);
+
+    uint32_t                         _k;
+    uint64_t                         _count;
+    size_t                           _size;
+    size_t                           _capacity;
+    uint32_t                         _compactions;
+    std::vector<std::vector<double>> _levels;
+};
+
+inline uint32_t
+KllSketch::levelCapacity(size_t level) const {
+    size_t depth = _levels.size() - 1 - level;
+    return std::max(2u, static_cast<uint32_t>(std::ceil(_k * std::pow(CAPACITY_DECAY, depth))));
+}
+
+inline size_t
+KllSketch::calcCapacity() const {
+    size_t result = 0;
+    for (size_t level = 0; level < _levels.size(); ++level) {
+        result += levelCapacity(level);
+    }
+    return result;
+}
+
+inline void
+KllSketch::aggregate(double value) {
+    if (std::isnan(value)) {
+        return;
+    }
+    _levels[0].push_back(value);
+    ++_count;
+    ++_size;
+    if (_size > _capacity) {
+        compress();
+    }
+}
+
+inline void
+KllSketch::compact(size_t level) {
+    if (level + 1 == _levels.size()) {
+        _levels.emplace_back();
+        _capacity = calcCapacity();
+    }
+    std::vector<double> &items = _levels[level];
+    std::sort(items.begin(), items.end());
+    // An odd item out stays at this level to keep the total weight exact.
+    size_t keep = items.size() % 2;
+    size_t offset = (_compactions++) % 2;
+    std::vector<double> &next = _levels[level + 1];
+    for (size_t i = keep + offset; i < items.size(); i += 2) {
+        next.push_back(items[i]);
+    }
+    _size -= (items.size() - keep) / 2;
+    items.resize(keep);
+}
+
+inline void
+KllSketch::compress() {
+    while (_size > _capacity) {
+        for (size_t level = 0; level < _levels.size(); ++level) {
+            if (_levels[level].size() >= levelCapacity(level)) {
+                compact(level);
+                break;
+            }
+        }
+    }
+}
+
+inline void
+KllSketch::merge(const KllSketch &other) {
+    while (_levels.size() < other._levels.size()) {
+        _levels.emplace_back();
+    }
+    for (size_t level = 0; level < other._levels.size(); ++level) {
+        const auto &items = other._levels[level];
+        _levels[level].insert(_levels[level].end(), items.begin(), items.end());
+    }
+    _count += other._count;
+    _size += other._size;
+    _capacity = calcCapacity();
+    compress();
+}
+
+inline double
+KllSketch::quantile(double q) const {
+    std::vector<std::pair<double, uint64_t>> weighted;
+    weighted.reserve(getSize());
+    uint64_t total = 0;
+    for (size_t level = 0; level < _levels.size(); ++level) {
+        uint64_t weight = uint64_t(1) << level;
+        for (double value : _levels[level]) {
+            weighted.emplace_back(value, weight);
+            total += weight;
+        }
+    }
+    if (weighted.empty()) {
+        return std::nan("");
+    }
+    std::sort(weighted.begin(), weighted.end());
+    double wanted = std::clamp(q, 0.0, 1.0) * total;
+    uint64_t seen = 0;
+    for (const auto &entry : weighted) {
+        seen += entry.second;
+        if (seen >= wanted) {
+            return entry.first;
+        }
+    }
+    return weighted.back().first;
+}
+
+inline void
+KllSketch::serialize(vespalib::Serializer &os) const {
+    uint32_t num_levels = _levels.size();
+    os << _k << _count << num_levels;
+    for (const auto &level : _levels) {
+        uint32_t size = level.size();
+        os << size;
+        for (double value : level) {
+            os << value;
+        }
+    }
+}
+
+inline void
+KllSketch::deserialize(vespalib::Deserializer &is) {
+    uint32_t num_levels;
+    is >> _k >> _count >> num_levels;
+    _levels.assign(std::max(num_levels, 1u), std::vector<double>());
+    _size = 0;
+    for (uint32_t i = 0; i < num_levels; ++i) {
+        uint32_t size;
+        is >> size;
+        _levels[i].resize(size);
+        for (double &value : _levels[i]) {
+            is >> value;
+        }
+        _size += size;
+    }
+    _capacity = calcCapacity();
+}
+
+}  // namespace search
@@ -19,6 +19,7 @@
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
+#include <vespa/vespalib/stllike/hash_set.hpp>
 #include <stdexcept>
 
 namespace search::memoryindex {
@@ -69,6 +70,7 @@ FieldInverter::reset()
     _elems.clear();
     _positions.clear();
     _wordRefs.resize(1);
+    _uniqueWords.clear();
     _pendingDocs.clear();
     _abortedDocs.clear();
     _removeDocs.clear();
@@ -86,7 +88,8 @@ FieldInverter::sortWords()
 
     // Make a dictionary for words.
     { // Use radix sort based on first four bytes of word, before finalizing with std::sort.
-        vespalib::Array<uint64_t> firstFourBytes(_wordRefs.size());
+        auto &firstFourBytes = _wordSortBuffer; // Reused across batches
+        firstFourBytes.resize(_wordRefs.size());
         for (size_t i(1); i < _wordRefs.size(); i++) {
             uint64_t firstFour = ntohl(*reinterpret_cast<const uint32_t *>(getWordFromRef(_wordRefs[i])));
             firstFourBytes[i] = (firstFour << 32) | _wordRefs[i];
@@ -99,7 +102,6 @@ FieldInverter::sortWords()
     }
     // Populate word numbers in word buffer and mapping from
     // word numbers to word reference.
-    // TODO: shrink word buffer to only contain unique words
     auto w(_wordRefs.begin() + 1);
     auto we(_wordRefs.end());
     uint32_t wordNum = 1;   // First valid word number
@@ -108,7 +110,7 @@ FieldInverter::sortWords()
     for (++w; w != we; ++w) {
         const char *word = getWordFromRef(*w);
         int cmpres = strcmp(lastWord, word);
-        assert(cmpres <= 0);
+        assert(cmpres < 0); // Words are unique within a batch
         if (cmpres < 0) {
             ++wordNum;
             _wordRefs[wordNum] = *w;
@@ -141,6 +143,10 @@ FieldInverter::endElement()
 uint32_t
 FieldInverter::saveWord(std::string_view word)
 {
+    auto found = _uniqueWords.find(word);
+    if (found != _uniqueWords.end()) {
+        return *found;
+    }
     const size_t wordsSize = _words.size();
     // assert((wordsSize & 3) == 0); // Check alignment
     const size_t unpadded_size = wordsSize + 4 + word.size() + 1;
@@ -156,6 +162,7 @@ FieldInverter::saveWord(std::string_view word)
     uint32_t wordRef = (wordsSize + 4) >> 2;
     // assert(wordRef != 0);
     _wordRefs.push_back(wordRef);
+    _uniqueWords.insert(wordRef);
     return wordRef;
 }
 
@@ -255,6 +262,8 @@ FieldInverter::FieldInverter(const Schema &schema, uint32_t fieldId,
       _positions(),
       _features(),
       _wordRefs(1),
+      _uniqueWords(1, WordRefHash(&_words), WordRefEqual(&_words)),
+      _wordSortBuffer(),
       _terms(),
       _abortedDocs(),
       _pendingDocs(),
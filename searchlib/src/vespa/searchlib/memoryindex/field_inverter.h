@@ -8,6 +8,7 @@
 #include <vespa/searchlib/util/token_extractor.h>
 #include <vespa/vespalib/stllike/allocator.h>
 #include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/stllike/hash_set.h>
 #include <limits>
 
 namespace search::index {
@@ -139,6 +140,31 @@ private:
         }
     };
 
+    /*
+     * Hash and equality for word references, also accepting the word itself as lookup key.
+     * Used to store each distinct word only once in the word buffer for a batch of documents.
+     */
+    class WordRefHash {
+        const WordBuffer *_wordBuffer;
+    public:
+        explicit WordRefHash(const WordBuffer *wordBuffer) noexcept : _wordBuffer(wordBuffer) { }
+        size_t operator()(std::string_view word) const noexcept { return vespalib::hashValue(word.data(), word.size()); }
+        size_t operator()(uint32_t wordRef) const noexcept {
+            return (*this)(std::string_view(&(*_wordBuffer)[static_cast<size_t>(wordRef) << 2]));
+        }
+    };
+
+    class WordRefEqual {
+        const WordBuffer *_wordBuffer;
+        std::string_view getWord(uint32_t wordRef) const noexcept {
+            return &(*_wordBuffer)[static_cast<size_t>(wordRef) << 2];
+        }
+    public:
+        explicit WordRefEqual(const WordBuffer *wordBuffer) noexcept : _wordBuffer(wordBuffer) { }
+        bool operator()(uint32_t lhs, uint32_t rhs) const noexcept { return lhs == rhs; }
+        bool operator()(uint32_t lhs, std::string_view rhs) const noexcept { return getWord(lhs) == rhs; }
+    };
+
     /*
      * Range in _positions vector used to represent a document put.
      */
@@ -165,6 +191,8 @@ private:
     };
 
     using UInt32Vector = std::vector<uint32_t, vespalib::allocator_large<uint32_t>>;
+    using UInt64Vector = std::vector<uint64_t, vespalib::allocator_large<uint64_t>>;
+    using WordRefSet = vespalib::hash_set<uint32_t, WordRefHash, WordRefEqual>;
     // Current field state.
     const uint32_t                 _fieldId;   // current field id
     uint32_t                       _elem;      // current element
@@ -180,6 +208,8 @@ private:
     PosInfoVec                     _positions;
     index::DocIdAndPosOccFeatures  _features;
     UInt32Vector                   _wordRefs;
+    WordRefSet                     _uniqueWords;  // word references in _wordRefs, keyed by word
+    UInt64Vector                   _wordSortBuffer;
 
     using SpanTerm = linguistics::TokenExtractor::SpanTerm;
     std::vector<SpanTerm>          _terms;
@@ -202,6 +232,7 @@ public:
 private:
     /**
      * Save the given word in the word buffer and return the word reference.
+     * A word already saved in the current batch is not saved again.
      */
     VESPA_DLL_LOCAL uint32_t saveWord(std::string_view word);
 
@@ -97,6 +97,7 @@ DenseTensorStore::DenseTensorStore(const ValueType &type, std::shared_ptr<vespal
 
 DenseTensorStore::~DenseTensorStore()
 {
+    drop_compaction_context();
     _store.dropBuffers();
 }
 
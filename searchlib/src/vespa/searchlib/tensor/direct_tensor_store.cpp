@@ -59,7 +59,10 @@ DirectTensorStore::DirectTensorStore(const vespalib::eval::ValueType& tensor_typ
     _tensor_store.enableFreeLists();
 }
 
-DirectTensorStore::~DirectTensorStore() = default;
+DirectTensorStore::~DirectTensorStore()
+{
+    drop_compaction_context();
+}
 
 void
 DirectTensorStore::holdTensor(EntryRef ref)
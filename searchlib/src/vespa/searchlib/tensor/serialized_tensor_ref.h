@@ -21,6 +21,9 @@ public:
     ~SerializedTensorRef();
     const VectorBundle& get_vectors() const noexcept { return _vectors; }
     std::span<const vespalib::string_id> get_labels(uint32_t subspace) const;
+    // labels for all subspaces, in subspace order
+    std::span<const vespalib::string_id> get_all_labels() const noexcept { return _labels; }
+    uint32_t get_num_mapped_dimensions() const noexcept { return _num_mapped_dimensions; }
 };
 
 }
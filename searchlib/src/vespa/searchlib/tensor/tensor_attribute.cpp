@@ -15,7 +15,6 @@
 #include <vespa/searchcommon/attribute/config.h>
 #include <vespa/vespalib/data/slime/cursor.h>
 #include <vespa/vespalib/data/slime/inserter.h>
-#include <vespa/vespalib/datastore/i_compaction_context.h>
 #include <vespa/vespalib/util/shared_string_repo.h>
 #include <vespa/eval/eval/fast_value.h>
 #include <vespa/eval/eval/value_codec.h>
@@ -101,10 +100,8 @@ TensorAttribute::onCommit()
 {
     incGeneration();
     if (_tensorStore.consider_compact()) {
-        auto context = _tensorStore.start_compact(getConfig().getCompactionStrategy());
-        if (context) {
-            context->compact(std::span<AtomicEntryRef>(&_refVector[0], _refVector.size()));
-        }
+        _tensorStore.compact_worst(std::span<AtomicEntryRef>(&_refVector[0], _refVector.size()),
+                                   getConfig().getCompactionStrategy());
         _compactGeneration = getCurrentGeneration();
         incGeneration();
         updateStat(true);
@@ -11,7 +11,6 @@
 
 using vespalib::MemoryUsage;
 using vespalib::SharedStringRepo;
-using vespalib::StringIdVector;
 using vespalib::eval::FastAddrMap;
 using vespalib::eval::FastValueIndex;
 using vespalib::eval::StreamedValueView;
@@ -160,8 +159,7 @@ TensorBufferOperations::encode_stored_tensor(std::span<const char> buf, const ve
     auto cells_start_offset = get_cells_offset(num_subspaces, aligner);
     TypedCells cells(buf.data() + cells_start_offset, _subspace_type.cell_type(), cells_size);
     assert(cells_start_offset + cells_mem_size <= buf.size());
-    StringIdVector labels_copy(labels.begin(), labels.end());
-    StreamedValueView streamed_value_view(tensor_type, _num_mapped_dimensions, cells, num_subspaces, labels_copy);
+    StreamedValueView streamed_value_view(tensor_type, _num_mapped_dimensions, cells, num_subspaces, labels);
     vespalib::eval::encode_value(streamed_value_view, target);
 }
 
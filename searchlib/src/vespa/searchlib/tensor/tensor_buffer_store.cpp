@@ -44,7 +44,10 @@ TensorBufferStore::TensorBufferStore(const ValueType& tensor_type, std::shared_p
 {
 }
 
-TensorBufferStore::~TensorBufferStore() = default;
+TensorBufferStore::~TensorBufferStore()
+{
+    drop_compaction_context();
+}
 
 void
 TensorBufferStore::holdTensor(EntryRef ref)
@@ -1,16 +1,38 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "tensor_store.h"
+#include <vespa/vespalib/datastore/compaction_strategy.h>
+#include <vespa/vespalib/datastore/i_compaction_context.h>
 
 namespace search::tensor {
 
 TensorStore::TensorStore(vespalib::datastore::DataStoreBase &store)
     : _store(store),
-      _compaction_spec()
+      _compaction_spec(),
+      _compaction_context()
 { }
 
 TensorStore::~TensorStore() = default;
 
+void
+TensorStore::compact_worst(std::span<AtomicEntryRef> refs, const vespalib::datastore::CompactionStrategy& compaction_strategy)
+{
+    if (!_compaction_context) {
+        _compaction_context = start_compact(compaction_strategy);
+    }
+    if (_compaction_context) {
+        if (_compaction_context->compact_step(refs, compaction_strategy.get_compaction_step_size())) {
+            _compaction_context.reset();
+        }
+    }
+}
+
+void
+TensorStore::drop_compaction_context() noexcept
+{
+    _compaction_context.reset();
+}
+
 const DenseTensorStore*
 TensorStore::as_dense() const
 {
@@ -2,11 +2,13 @@
 
 #pragma once
 
+#include <vespa/vespalib/datastore/atomic_entry_ref.h>
 #include <vespa/vespalib/datastore/compaction_spec.h>
 #include <vespa/vespalib/datastore/datastorebase.h>
 #include <vespa/vespalib/datastore/entryref.h>
 #include <vespa/vespalib/datastore/i_compactable.h>
 #include <vespa/vespalib/util/generationhandler.h>
+#include <span>
 
 namespace vespalib { class nbostream; }
 namespace vespalib::datastore { struct ICompactionContext; }
@@ -26,6 +28,7 @@ class DenseTensorStore;
 class TensorStore : public vespalib::datastore::ICompactable
 {
 public:
+    using AtomicEntryRef = vespalib::datastore::AtomicEntryRef;
     using EntryRef = vespalib::datastore::EntryRef;
     using generation_t = vespalib::GenerationHandler::generation_t;
 
@@ -33,6 +36,11 @@ protected:
     vespalib::datastore::DataStoreBase& _store;
     vespalib::datastore::CompactionSpec _compaction_spec;
 
+    // Drops a pending compaction. Only used by derived stores when they are destroyed.
+    void drop_compaction_context() noexcept;
+private:
+    std::unique_ptr<vespalib::datastore::ICompactionContext> _compaction_context;
+
 public:
     TensorStore(vespalib::datastore::DataStoreBase &store);
 
@@ -44,6 +52,14 @@ public:
 
     virtual std::unique_ptr<vespalib::datastore::ICompactionContext> start_compact(const vespalib::datastore::CompactionStrategy& compaction_strategy) = 0;
 
+    /*
+     * Compacts the worst buffers, moving the tensors referenced by the given refs. With a
+     * compaction step size in the compaction strategy, at most that many refs are handled
+     * per call and the compaction continues on the following calls.
+     */
+    void compact_worst(std::span<AtomicEntryRef> refs, const vespalib::datastore::CompactionStrategy& compaction_strategy);
+    bool is_compacting() const noexcept { return static_cast<bool>(_compaction_context); }
+
     virtual EntryRef store_tensor(const vespalib::eval::Value& tensor) = 0;
     virtual EntryRef store_encoded_tensor(vespalib::nbostream& encoded) = 0;
     virtual std::unique_ptr<vespalib::eval::Value> get_tensor(EntryRef ref) const = 0;
@@ -74,7 +90,7 @@ public:
     }
 
     bool consider_compact() const noexcept {
-        return _compaction_spec.compact() && !_store.has_held_buffers();
+        return is_compacting() || (_compaction_spec.compact() && !_store.has_held_buffers());
     }
 };
 
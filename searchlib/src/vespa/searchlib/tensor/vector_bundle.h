@@ -41,6 +41,10 @@ public:
     vespalib::eval::TypedCells cells(uint32_t subspace) const noexcept {
         return {static_cast<const char*>(_data) + _subspace_mem_size * subspace, _cell_type, _subspace_size};
     }
+    // cells for all subspaces (stored back to back)
+    vespalib::eval::TypedCells all_cells() const noexcept {
+        return {_data, _cell_type, _subspace_size * _subspaces};
+    }
 };
 
 }
@@ -2,6 +2,7 @@
 
 #include "domain.h"
 #include "domainpart.h"
+#include "group_syncer.h"
 #include "session.h"
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/io/fileutil.h>
@@ -43,12 +44,13 @@ VESPA_THREAD_STACK_TAG(tls_domain_commit);
 }
 
 Domain::Domain(const string &domainName, const string & baseDir, vespalib::Executor & executor,
-               const DomainConfig & cfg, const FileHeaderContext &fileHeaderContext)
+               GroupSyncer & groupSyncer, const DomainConfig & cfg, const FileHeaderContext &fileHeaderContext)
     : _config(cfg),
       _currentChunk(createCommitChunk(cfg)),
       _lastSerial(0),
       _singleCommitter(std::make_unique<vespalib::ThreadStackExecutor>(1, CpuUsage::wrap(tls_domain_commit, CpuCategory::WRITE))),
       _executor(executor),
+      _groupSyncer(groupSyncer),
       _sessionId(1),
       _name(domainName),
       _parts(),
@@ -384,17 +386,19 @@ Domain::commitChunk(std::unique_ptr<CommitChunk> chunk, const UniqueLock & chunk
 
 
 void
-Domain::doCommit(const SerializedChunk & serialized) {
+Domain::doCommit(SerializedChunk serialized) {
 
     SerialNumRange range = serialized.range();
     DomainPart::SP dp = optionallyRotateFile(range.from());
     dp->commit(serialized);
-    if (_config.getFSyncOnCommit()) {
-        dp->sync();
-    }
     cleanSessions();
     LOG(debug, "Releasing %zu acks and %zu entries and %zu bytes.",
         serialized.getNumCallBacks(), serialized.getNumEntries(), serialized.getData().size());
+    if (_config.useGroupSync()) {
+        _groupSyncer.sync(std::move(dp), serialized.stealCommitChunk());
+    } else if (_config.getFSyncOnCommit()) {
+        dp->sync();
+    }
 }
 
 bool
@@ -11,6 +11,7 @@ namespace search::common { class FileHeaderContext; }
 namespace search::transactionlog {
 
 class DomainPart;
+class GroupSyncer;
 class Session;
 
 class Domain : public Writer
@@ -20,7 +21,7 @@ public:
     using DomainPartSP = std::shared_ptr<DomainPart>;
     using FileHeaderContext = common::FileHeaderContext;
     Domain(const std::string &name, const std::string &baseDir, vespalib::Executor & executor,
-           const DomainConfig & cfg, const FileHeaderContext &fileHeaderContext);
+           GroupSyncer & groupSyncer, const DomainConfig & cfg, const FileHeaderContext &fileHeaderContext);
 
     ~Domain() override;
 
@@ -63,7 +64,7 @@ private:
 
     std::unique_ptr<CommitChunk> grabCurrentChunk(const UniqueLock & guard);
     void commitChunk(std::unique_ptr<CommitChunk> chunk, const UniqueLock & chunkOrderGuard);
-    void doCommit(const SerializedChunk & serialized);
+    void doCommit(SerializedChunk serialized);
     SerialNum begin(const UniqueLock & guard) const;
     SerialNum end(const UniqueLock & guard) const;
     size_t byteSize(const UniqueLock & guard) const;
@@ -87,6 +88,7 @@ private:
     SerialNum                    _lastSerial;
     std::unique_ptr<Executor>    _singleCommitter;
     Executor                    &_executor;
+    GroupSyncer                 &_groupSyncer;
     std::atomic<int>             _sessionId;
     std::string             _name;
     DomainPartList               _parts;
@@ -16,17 +16,21 @@ public:
     DomainConfig & setChunkSizeLimit(size_t v)      { _chunkSizeLimit = v; return *this; }
     DomainConfig & setCompressionLevel(uint8_t v)   { _compressionLevel = v; return *this; }
     DomainConfig & setFSyncOnCommit(bool v)         { _fSyncOnCommit = v; return *this; }
+    DomainConfig & setGroupSyncMaxLatency(duration v) { _groupSyncMaxLatency = v; return *this; }
     Encoding          getEncoding() const { return _encoding; }
     size_t       getPartSizeLimit() const { return _partSizeLimit; }
     size_t      getChunkSizeLimit() const { return _chunkSizeLimit; }
     uint8_t   getCompressionlevel() const { return _compressionLevel; }
     bool         getFSyncOnCommit() const { return _fSyncOnCommit; }
+    duration getGroupSyncMaxLatency() const { return _groupSyncMaxLatency; }
+    bool           useGroupSync() const { return _fSyncOnCommit && (_groupSyncMaxLatency > duration::zero()); }
 private:
     Encoding     _encoding;
     uint8_t      _compressionLevel;
     bool         _fSyncOnCommit;
     size_t       _partSizeLimit;
     size_t       _chunkSizeLimit;
+    duration     _groupSyncMaxLatency;
 };
 
 struct PartInfo {
@@ -0,0 +1,121 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "group_syncer.h"
+#include "domainpart.h"
+#include <algorithm>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".transactionlog.group_syncer");
+
+namespace search::transactionlog {
+
+GroupSyncer::PendingSync::PendingSync(std::shared_ptr<DomainPart> part_in, std::unique_ptr<CommitChunk> chunk_in) noexcept
+    : part(std::move(part_in)),
+      chunk(std::move(chunk_in))
+{}
+GroupSyncer::PendingSync::PendingSync(PendingSync &&) noexcept = default;
+GroupSyncer::PendingSync & GroupSyncer::PendingSync::operator=(PendingSync &&) noexcept = default;
+GroupSyncer::PendingSync::~PendingSync() = default;
+
+GroupSyncer::GroupSyncer(duration maxLatency)
+    : _lock(),
+      _cond(),
+      _maxLatency(maxLatency),
+      _oldestPending(),
+      _pending(),
+      _stats(),
+      _closed(false),
+      _thread()
+{
+    _thread = std::thread([this]() { run(); });
+}
+
+GroupSyncer::~GroupSyncer()
+{
+    {
+        std::lock_guard guard(_lock);
+        _closed = true;
+    }
+    _cond.notify_all();
+    _thread.join();
+}
+
+void
+GroupSyncer::setMaxLatency(duration maxLatency)
+{
+    {
+        std::lock_guard guard(_lock);
+        _maxLatency = maxLatency;
+    }
+    _cond.notify_all();
+}
+
+void
+GroupSyncer::sync(std::shared_ptr<DomainPart> part, std::unique_ptr<CommitChunk> pending)
+{
+    bool wakeup = false;
+    {
+        std::lock_guard guard(_lock);
+        if (_pending.empty()) {
+            _oldestPending = vespalib::steady_clock::now();
+            wakeup = true;
+        }
+        _pending.emplace_back(std::move(part), std::move(pending));
+    }
+    if (wakeup) {
+        _cond.notify_all();
+    }
+}
+
+GroupSyncStats
+GroupSyncer::getStats()
+{
+    std::lock_guard guard(_lock);
+    GroupSyncStats stats = _stats;
+    _stats = GroupSyncStats();
+    return stats;
+}
+
+size_t
+GroupSyncer::syncBatch(PendingList & batch)
+{
+    std::vector<DomainPart *> parts;
+    parts.reserve(batch.size());
+    for (const auto & pending : batch) {
+        if (std::find(parts.begin(), parts.end(), pending.part.get()) == parts.end()) {
+            parts.push_back(pending.part.get());
+        }
+    }
+    for (DomainPart * part : parts) {
+        part->sync();
+    }
+    return parts.size();
+}
+
+void
+GroupSyncer::run()
+{
+    UniqueLock guard(_lock);
+    for (;;) {
+        _cond.wait(guard, [this]() { return _closed || !_pending.empty(); });
+        if (_pending.empty()) {
+            break;
+        }
+        // Give commits from other domains a chance to join this batch, but never beyond max latency.
+        _cond.wait_until(guard, _oldestPending + _maxLatency, [this]() {
+            return _closed || (vespalib::steady_clock::now() >= _oldestPending + _maxLatency);
+        });
+        PendingList batch;
+        batch.swap(_pending);
+        guard.unlock();
+        size_t numSyncs = syncBatch(batch);
+        size_t batchSize = batch.size();
+        LOG(spam, "Synced %zu domain parts for %zu commits", numSyncs, batchSize);
+        batch.clear(); // Releases the acks for all commits in the batch
+        guard.lock();
+        _stats.batchSize.add(batchSize);
+        _stats.numSyncs += numSyncs;
+    }
+}
+
+}
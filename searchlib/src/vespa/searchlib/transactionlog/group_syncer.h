@@ -0,0 +1,71 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/vespalib/util/executor_stats.h>
+#include <vespa/vespalib/util/time.h>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace search::transactionlog {
+
+class CommitChunk;
+class DomainPart;
+
+/**
+ * Group sync statistics sampled since the previous call to GroupSyncer::getStats().
+ */
+struct GroupSyncStats {
+    using BatchSize = vespalib::AggregatedAverage<size_t>;
+    BatchSize batchSize; // Number of commits acked per batch
+    size_t    numSyncs;  // Number of domain part syncs issued
+    GroupSyncStats() noexcept : batchSize(), numSyncs(0) {}
+};
+
+/**
+ * Coalesces syncing of committed chunks across all domains in a transaction log server.
+ *
+ * A commit handed over is held back (not acked) until the domain part it was written to
+ * has been synced. Pending commits are collected for at most max latency after the first
+ * one arrived, then each distinct domain part in the batch is synced once and all commits
+ * in the batch are released.
+ */
+class GroupSyncer {
+public:
+    using duration = vespalib::duration;
+    explicit GroupSyncer(duration maxLatency);
+    GroupSyncer(const GroupSyncer &) = delete;
+    GroupSyncer & operator=(const GroupSyncer &) = delete;
+    ~GroupSyncer();
+
+    void setMaxLatency(duration maxLatency);
+    void sync(std::shared_ptr<DomainPart> part, std::unique_ptr<CommitChunk> pending);
+    GroupSyncStats getStats();
+private:
+    struct PendingSync {
+        std::shared_ptr<DomainPart>  part;
+        std::unique_ptr<CommitChunk> chunk;
+        PendingSync(std::shared_ptr<DomainPart> part_in, std::unique_ptr<CommitChunk> chunk_in) noexcept;
+        PendingSync(PendingSync &&) noexcept;
+        PendingSync & operator=(PendingSync &&) noexcept;
+        ~PendingSync();
+    };
+    using PendingList = std::vector<PendingSync>;
+    using UniqueLock = std::unique_lock<std::mutex>;
+
+    void run();
+    size_t syncBatch(PendingList & batch);
+
+    std::mutex               _lock;
+    std::condition_variable  _cond;
+    duration                 _maxLatency;
+    vespalib::steady_time    _oldestPending;
+    PendingList              _pending;
+    GroupSyncStats           _stats;
+    bool                     _closed;
+    std::thread              _thread;
+};
+
+}
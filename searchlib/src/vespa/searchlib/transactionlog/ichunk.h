@@ -48,6 +48,7 @@ public:
     SerialNumRange range() const { return _range; }
     size_t getNumEntries() const { return _numEntries; }
     size_t getNumCallBacks() const { return _commitChunk->getNumCallBacks(); }
+    std::unique_ptr<CommitChunk> stealCommitChunk() { return std::move(_commitChunk); }
 private:
     // CommitChunk is required to ensure we do not reply until committed to the TLS.
     std::unique_ptr<CommitChunk> _commitChunk;
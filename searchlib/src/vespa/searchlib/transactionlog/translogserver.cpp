@@ -2,6 +2,7 @@
 #include "translogserver.h"
 #include "domain.h"
 #include "client_common.h"
+#include "group_syncer.h"
 #include <vespa/fnet/frt/rpcrequest.h>
 #include <vespa/fnet/frt/supervisor.h>
 #include <vespa/fnet/transport.h>
@@ -98,6 +99,7 @@ TransLogServer::TransLogServer(FNET_Transport & transport, const std::string &na
       _baseDir(baseDir),
       _domainConfig(cfg),
       _executor(maxThreads, CpuUsage::wrap(tls_executor, CpuUsage::Category::WRITE)),
+      _groupSyncer(std::make_unique<GroupSyncer>(cfg.getGroupSyncMaxLatency())),
       _thread(),
       _supervisor(std::make_unique<FRT_Supervisor>(&transport)),
       _domains(),
@@ -114,7 +116,7 @@ TransLogServer::TransLogServer(FNET_Transport & transport, const std::string &na
                 domainDir >> domainName;
                 if ( ! domainName.empty()) {
                     try {
-                        auto domain = make_shared<Domain>(domainName, dir(), _executor, cfg, _fileHeaderContext);
+                        auto domain = make_shared<Domain>(domainName, dir(), _executor, *_groupSyncer, cfg, _fileHeaderContext);
                         _domains[domain->name()] = domain;
                     } catch (const std::exception & e) {
                         LOG(warning, "Failed creating %s domain on startup. Exception = %s", domainName.c_str(), e.what());
@@ -208,12 +210,19 @@ TransLogServer &
 TransLogServer::setDomainConfig(const DomainConfig & cfg) {
     WriteGuard domainGuard(_domainMutex);
     _domainConfig = cfg;
+    _groupSyncer->setMaxLatency(cfg.getGroupSyncMaxLatency());
     for(auto &domain: _domains) {
         domain.second->setConfig(cfg);
     }
     return *this;
 }
 
+GroupSyncStats
+TransLogServer::getGroupSyncStats()
+{
+    return _groupSyncer->getStats();
+}
+
 DomainStats
 TransLogServer::getDomainStats() const
 {
@@ -438,7 +447,7 @@ TransLogServer::createDomain(FRT_RPCRequest *req)
     Domain::SP domain(findDomain(domainName));
     if ( !domain ) {
         try {
-            domain = std::make_shared<Domain>(domainName, dir(), _executor, _domainConfig, _fileHeaderContext);
+            domain = std::make_shared<Domain>(domainName, dir(), _executor, *_groupSyncer, _domainConfig, _fileHeaderContext);
             {
                 WriteGuard domainGuard(_domainMutex);
                 _domains[domain->name()] = domain;
@@ -17,6 +17,8 @@ namespace search::transactionlog {
 
 class TransLogServerExplorer;
 class Domain;
+class GroupSyncer;
+struct GroupSyncStats;
 
 class TransLogServer : private FRT_Invokable, public WriterFactory
 {
@@ -32,6 +34,7 @@ public:
                    const common::FileHeaderContext &fileHeaderContext);
     ~TransLogServer() override;
     DomainStats getDomainStats() const;
+    GroupSyncStats getGroupSyncStats();
     std::shared_ptr<Writer> getWriter(const std::string & domainName) const override;
     TransLogServer & setDomainConfig(const DomainConfig & cfg);
 
@@ -69,6 +72,7 @@ private:
     std::string                    _baseDir;
     DomainConfig                        _domainConfig;
     vespalib::ThreadStackExecutor       _executor;
+    std::unique_ptr<GroupSyncer>        _groupSyncer;   // Shared by all domains, must outlive them
     std::thread                         _thread;
     std::unique_ptr<FRT_Supervisor>     _supervisor;
     DomainList                          _domains;
@@ -6,7 +6,7 @@
 #include <vespa/config-ranking-constants.h>
 #include <vespa/config-ranking-expressions.h>
 #include <vespa/config/retriever/configsnapshot.hpp>
-#include <vespa/eval/eval/fast_value.h>
+#include <vespa/eval/eval/value_cache/constant_value_cache.h>
 #include <vespa/searchlib/fef/ranking_assets_builder.h>
 #include <vespa/searchlib/fef/ranking_assets_repo.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
@@ -36,8 +36,6 @@ SearchEnvironment::Env::Env(const config::ConfigUri& configUri, const Fast_Norma
       _rankManager(std::make_unique<RankManager>(_vsmAdapter.get())),
       _snapshot(),
       _lock(),
-      _tensor_loader(vespalib::eval::FastValueBuilderFactory::get()),
-      _constant_value_cache(_tensor_loader),
       _generation(-1),
       _onnx_models(),
       _ranking_constants(),
@@ -72,7 +70,7 @@ SearchEnvironment::Env::configure(const config::ConfigSnapshot & snapshot)
     configure_ranking_asset<vespa::config::search::core::OnnxModelsConfig, OnnxModels>(_onnx_models, snapshot, builder);
     configure_ranking_asset<vespa::config::search::core::RankingConstantsConfig, RankingConstants>(_ranking_constants, snapshot, builder);
     configure_ranking_asset<vespa::config::search::core::RankingExpressionsConfig, RankingExpressions>(_ranking_expressions, snapshot, builder);
-    _ranking_assets_repo = std::make_shared<const RankingAssetsRepo>(_constant_value_cache, _ranking_constants, _ranking_expressions, _onnx_models);
+    _ranking_assets_repo = std::make_shared<const RankingAssetsRepo>(vespalib::eval::ConstantValueCache::shared_tensor_cache(), _ranking_constants, _ranking_expressions, _onnx_models);
     _generation = snapshot.getGeneration();
     _vsmAdapter->configure(snap);
     _rankManager->configure(snap, _ranking_assets_repo);
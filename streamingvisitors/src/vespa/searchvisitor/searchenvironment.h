@@ -3,8 +3,6 @@
 #pragma once
 
 #include "rankmanager.h"
-#include <vespa/eval/eval/value_cache/constant_tensor_loader.h>
-#include <vespa/eval/eval/value_cache/constant_value_cache.h>
 #include <vespa/searchsummary/docsummary/juniperproperties.h>
 #include <vespa/storage/visiting/visitor.h>
 #include <vespa/config/retriever/simpleconfigurer.h>
@@ -52,8 +50,6 @@ private:
         std::unique_ptr<RankManager>                           _rankManager;
         std::shared_ptr<const SearchEnvironmentSnapshot>       _snapshot;
         std::mutex                                             _lock;
-        vespalib::eval::ConstantTensorLoader                   _tensor_loader;
-        vespalib::eval::ConstantValueCache                     _constant_value_cache;
         uint64_t                                               _generation;
         std::shared_ptr<const search::fef::OnnxModels>         _onnx_models;
         std::shared_ptr<const search::fef::RankingConstants>   _ranking_constants;
@@ -195,6 +195,83 @@ TEST_F(BTreeStoreTest, require_that_btree_roots_are_compacted)
     test_compact_sequence(10);
 }
 
+TEST_F(BTreeStoreTest, require_that_batches_are_applied_to_frozen_tree)
+{
+    EntryRef root = add_sequence(0, 1000);
+    inc_generation();
+    std::vector<TreeStore::KeyDataType> additions;
+    std::vector<TreeStore::KeyType> removals;
+    // Large batch spread over the whole tree
+    for (int i = 0; i < 1000; i += 2) {
+        removals.emplace_back(i);
+    }
+    for (int i = 1000; i < 1500; ++i) {
+        additions.emplace_back(i, 0);
+    }
+    _store.apply(root, additions.data(), additions.data() + additions.size(), removals.data(), removals.data() + removals.size());
+    inc_generation();
+    std::vector<int> exp;
+    for (int i = 1; i < 1000; i += 2) {
+        exp.emplace_back(i);
+    }
+    auto tail = make_exp_sequence(1000, 1500);
+    exp.insert(exp.end(), tail.begin(), tail.end());
+    EXPECT_EQ(exp, get_sequence(root));
+    // Small batch
+    additions.clear();
+    removals.clear();
+    additions.emplace_back(500, 0);
+    removals.emplace_back(1499);
+    _store.apply(root, additions.data(), additions.data() + additions.size(), removals.data(), removals.data() + removals.size());
+    inc_generation();
+    exp.pop_back();
+    exp.insert(std::lower_bound(exp.begin(), exp.end(), 500), 500);
+    EXPECT_EQ(exp, get_sequence(root));
+    _store.clear(root);
+}
+
+TEST_F(BTreeStoreTest, require_that_cost_model_selects_rebuild_for_large_batches)
+{
+    // Tree with 1000 keys and 4 keys per leaf: rebuild costs 2 * 1000 + additions, while modifying
+    // costs (log2(1000 + additions) + 1) per change plus 4 for each touched leaf.
+    EXPECT_FALSE(TreeStore::useBuildTree(1000, 1, 0));
+    EXPECT_FALSE(TreeStore::useBuildTree(1000, 0, 1));
+    EXPECT_FALSE(TreeStore::useBuildTree(1000, 142, 0));
+    EXPECT_TRUE(TreeStore::useBuildTree(1000, 143, 0));
+    EXPECT_FALSE(TreeStore::useBuildTree(1000, 0, 142));
+    EXPECT_TRUE(TreeStore::useBuildTree(1000, 0, 143));
+    EXPECT_FALSE(TreeStore::useBuildTree(1000, 68, 68));
+    EXPECT_TRUE(TreeStore::useBuildTree(1000, 69, 69));
+    EXPECT_TRUE(TreeStore::useBuildTree(1000, 1000, 0));
+    // Small trees are cheap to rebuild
+    EXPECT_FALSE(TreeStore::useBuildTree(20, 4, 0));
+    EXPECT_TRUE(TreeStore::useBuildTree(20, 5, 0));
+}
+
+TEST_F(BTreeStoreTest, require_that_apply_modifies_or_rebuilds_frozen_tree_based_on_batch_size)
+{
+    auto apply_tail = [this](EntryRef &root, int num_additions) {
+        std::vector<TreeStore::KeyDataType> additions;
+        std::vector<TreeStore::KeyType> removals;
+        for (int i = 1000; i < 1000 + num_additions; ++i) {
+            additions.emplace_back(i, 0);
+        }
+        const int *first_key = &_store.begin(root).getKey();
+        _store.apply(root, additions.data(), additions.data() + additions.size(), removals.data(), removals.data() + removals.size());
+        inc_generation();
+        EXPECT_EQ(make_exp_sequence(0, 1000 + num_additions), get_sequence(root));
+        // Modifying a frozen tree only copies the leaves it touches, a rebuild replaces all leaves
+        return first_key == &_store.begin(root).getKey();
+    };
+    EntryRef small_batch_root = add_sequence(0, 1000);
+    EntryRef large_batch_root = add_sequence(0, 1000);
+    inc_generation();
+    EXPECT_TRUE(apply_tail(small_batch_root, 142));
+    EXPECT_FALSE(apply_tail(large_batch_root, 143));
+    _store.clear(small_batch_root);
+    _store.clear(large_batch_root);
+}
+
 }
 
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -440,6 +440,37 @@ TEST_F(NumberStoreTwoSmallBufferTypesTest, buffer_with_most_dead_space_is_compac
     test_compaction(*this);
 }
 
+TEST_F(NumberStoreTwoSmallBufferTypesTest, buffer_can_be_compacted_in_steps)
+{
+    std::vector<AtomicEntryRef> refs;
+    for (uint32_t i = 0; i < 5; ++i) {
+        refs.emplace_back(add({i, i}));
+    }
+    ASSERT_NO_FATAL_FAILURE(remove(add({9, 9})));
+    reclaim_memory();
+    uint32_t old_buffer_id = getBufferId(refs[0].load_relaxed());
+    store.set_compaction_spec(CompactionSpec(true, false));
+    auto ctx = store.compact_worst(CompactionStrategy());
+    ASSERT_TRUE(ctx);
+    std::span<AtomicEntryRef> span(refs);
+    EXPECT_FALSE(ctx->compact_step(span, 2));
+    EXPECT_NE(old_buffer_id, getBufferId(refs[1].load_relaxed()));
+    EXPECT_EQ(old_buffer_id, getBufferId(refs[2].load_relaxed()));
+    // Refs added while compacting are not in the compacting buffer.
+    refs.emplace_back(add({7, 7}));
+    EXPECT_NE(old_buffer_id, getBufferId(refs.back().load_relaxed()));
+    span = std::span<AtomicEntryRef>(refs);
+    EXPECT_FALSE(ctx->compact_step(span, 2));
+    EXPECT_TRUE(ctx->compact_step(span, 2));
+    EXPECT_FALSE(store.bufferState(EntryRefType(0, old_buffer_id)).isOnHold());
+    ctx.reset();
+    EXPECT_TRUE(store.bufferState(EntryRefType(0, old_buffer_id)).isOnHold());
+    for (uint32_t i = 0; i < 5; ++i) {
+        EXPECT_NE(old_buffer_id, getBufferId(refs[i].load_relaxed()));
+        assertGet(refs[i].load_relaxed(), {i, i});
+    }
+}
+
 namespace {
 
 template <typename Fixture>
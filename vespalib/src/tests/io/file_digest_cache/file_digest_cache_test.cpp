@@ -0,0 +1,76 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/io/file_digest_cache.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+
+using vespalib::FileDigestCache;
+using vespalib::FileStamp;
+using vespalib::Memory;
+
+namespace {
+
+const std::string file_name("file_digest_cache_test_file.txt");
+
+void write_file(const std::string &content, std::filesystem::file_time_type mtime)
+{
+    std::ofstream(file_name, std::ios::trunc) << content;
+    std::filesystem::last_write_time(file_name, mtime);
+}
+
+}
+
+struct FileDigestCacheTest : ::testing::Test {
+    size_t calls;
+    FileDigestCache<std::string> cache;
+    FileDigestCacheTest()
+        : calls(0),
+          cache([this](Memory content) { ++calls; return content.make_string(); }, 2)
+    {
+    }
+    ~FileDigestCacheTest() override {
+        std::filesystem::remove(file_name);
+    }
+};
+
+TEST_F(FileDigestCacheTest, missing_and_empty_files_have_no_digest)
+{
+    EXPECT_FALSE(cache.get("no_such_file.txt").has_value());
+    EXPECT_FALSE(FileStamp::of("no_such_file.txt").has_value());
+    write_file("", std::filesystem::file_time_type::clock::now());
+    EXPECT_FALSE(cache.get(file_name).has_value());
+    EXPECT_EQ(0u, calls);
+}
+
+TEST_F(FileDigestCacheTest, digest_is_memoized_until_file_changes)
+{
+    auto mtime = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+    write_file("foo", mtime);
+    EXPECT_EQ("foo", cache.get(file_name));
+    EXPECT_EQ("foo", cache.get(file_name));
+    EXPECT_EQ(1u, calls);
+    write_file("bar", mtime + std::chrono::seconds(1));
+    EXPECT_EQ("bar", cache.get(file_name));
+    EXPECT_EQ(2u, calls);
+    write_file("bazz", mtime + std::chrono::seconds(1));
+    EXPECT_EQ("bazz", cache.get(file_name));
+    EXPECT_EQ(3u, calls);
+    EXPECT_EQ(1u, cache.size());
+}
+
+TEST_F(FileDigestCacheTest, cache_is_cleared_when_full)
+{
+    write_file("foo", std::filesystem::file_time_type::clock::now());
+    std::filesystem::copy_file(file_name, file_name + ".1", std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::copy_file(file_name, file_name + ".2", std::filesystem::copy_options::overwrite_existing);
+    cache.get(file_name);
+    cache.get(file_name + ".1");
+    EXPECT_EQ(2u, cache.size());
+    cache.get(file_name + ".2");
+    EXPECT_EQ(1u, cache.size());
+    std::filesystem::remove(file_name + ".1");
+    std::filesystem::remove(file_name + ".2");
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,116 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/util/arena_memory_allocator.h>
+#include <vespa/vespalib/util/alloc.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <cstring>
+
+using vespalib::alloc::Alloc;
+using vespalib::alloc::ArenaMemoryAllocator;
+
+TEST(ArenaMemoryAllocatorTest, allocations_are_aligned_and_disjoint)
+{
+    ArenaMemoryAllocator arena;
+    auto a = arena.alloc(3);
+    auto b = arena.alloc(100);
+    auto c = arena.alloc(17);
+    for (auto buf: {a, b, c}) {
+        EXPECT_EQ(0u, uintptr_t(buf.get()) % ArenaMemoryAllocator::ALIGNMENT);
+    }
+    EXPECT_EQ(3u, a.size());
+    EXPECT_LE(static_cast<char *>(a.get()) + 3, static_cast<char *>(b.get()));
+    EXPECT_LE(static_cast<char *>(b.get()) + 100, static_cast<char *>(c.get()));
+    memset(a.get(), 1, a.size());
+    memset(b.get(), 2, b.size());
+    memset(c.get(), 3, c.size());
+    EXPECT_EQ(3u, arena.get_stats().allocations);
+    EXPECT_EQ(1u, arena.get_stats().block_allocations);
+    EXPECT_EQ(ArenaMemoryAllocator::MIN_BLOCK_SIZE, arena.capacity());
+}
+
+TEST(ArenaMemoryAllocatorTest, empty_allocation_gives_no_memory)
+{
+    ArenaMemoryAllocator arena;
+    auto buf = arena.alloc(0);
+    EXPECT_EQ(nullptr, buf.get());
+    EXPECT_EQ(0u, arena.get_stats().allocations);
+    EXPECT_EQ(0u, arena.capacity());
+}
+
+TEST(ArenaMemoryAllocatorTest, memory_is_reused_after_reset)
+{
+    ArenaMemoryAllocator arena;
+    auto first = arena.alloc(1000);
+    arena.free(first);
+    arena.reset();
+    auto second = arena.alloc(1000);
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_EQ(1u, arena.get_stats().block_allocations);
+}
+
+TEST(ArenaMemoryAllocatorTest, blocks_are_merged_on_reset)
+{
+    ArenaMemoryAllocator arena;
+    auto round = [&]() {
+                     for (size_t i = 0; i < 10; ++i) {
+                         arena.alloc(10000);
+                     }
+                     arena.reset();
+                 };
+    round();
+    size_t blocks = arena.get_stats().block_allocations;
+    EXPECT_GT(blocks, 1u);
+    EXPECT_EQ(0u, arena.capacity());
+    round();
+    EXPECT_EQ(blocks + 1, arena.get_stats().block_allocations);
+    EXPECT_GE(arena.capacity(), 100000u);
+    round();
+    round();
+    EXPECT_EQ(blocks + 1, arena.get_stats().block_allocations);
+}
+
+TEST(ArenaMemoryAllocatorTest, large_blocks_are_not_retained)
+{
+    ArenaMemoryAllocator arena(64_Ki);
+    arena.alloc(100_Ki);
+    EXPECT_EQ(100_Ki, arena.capacity());
+    arena.reset();
+    EXPECT_EQ(0u, arena.capacity());
+    arena.alloc(1000);
+    EXPECT_EQ(ArenaMemoryAllocator::MIN_BLOCK_SIZE, arena.capacity());
+}
+
+TEST(ArenaMemoryAllocatorTest, memory_usage_is_reported)
+{
+    ArenaMemoryAllocator arena;
+    EXPECT_EQ(0u, arena.get_memory_usage().allocatedBytes());
+    arena.alloc(1000);
+    arena.alloc(20_Ki);
+    auto usage = arena.get_memory_usage();
+    EXPECT_EQ(arena.capacity(), usage.allocatedBytes());
+    EXPECT_EQ(ArenaMemoryAllocator::MIN_BLOCK_SIZE + 20_Ki, usage.usedBytes());
+    arena.reset();
+    EXPECT_EQ(0u, arena.get_memory_usage().usedBytes());
+}
+
+TEST(ArenaMemoryAllocatorTest, default_retain_limit_bounds_memory_kept_between_rounds)
+{
+    ArenaMemoryAllocator arena;
+    arena.alloc(ArenaMemoryAllocator::DEFAULT_RETAIN_LIMIT);
+    arena.reset();
+    EXPECT_EQ(ArenaMemoryAllocator::DEFAULT_RETAIN_LIMIT, arena.capacity());
+    arena.alloc(ArenaMemoryAllocator::DEFAULT_RETAIN_LIMIT + 1);
+    arena.reset();
+    EXPECT_EQ(0u, arena.capacity());
+}
+
+TEST(ArenaMemoryAllocatorTest, arena_can_back_alloc_objects)
+{
+    ArenaMemoryAllocator arena;
+    Alloc buf = Alloc::alloc_with_allocator(&arena).create(1000);
+    memset(buf.get(), 0x55, buf.size());
+    Alloc bigger = buf.create(2000);
+    EXPECT_EQ(2000u, bigger.size());
+    EXPECT_EQ(2u, arena.get_stats().allocations);
+    EXPECT_EQ(1u, arena.get_stats().block_allocations);
+}
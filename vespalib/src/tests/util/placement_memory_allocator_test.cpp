@@ -0,0 +1,110 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/util/placement_memory_allocator.h>
+#include <vespa/vespalib/util/placement_memory_allocator_factory.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <cstring>
+
+using vespalib::IllegalArgumentException;
+using vespalib::alloc::MemoryAllocator;
+using vespalib::alloc::MemoryPlacement;
+using vespalib::alloc::PlacementMemoryAllocator;
+using vespalib::alloc::PlacementMemoryAllocatorFactory;
+using HugePages = MemoryPlacement::HugePages;
+using Numa = MemoryPlacement::Numa;
+
+namespace {
+
+const PlacementMemoryAllocator *as_placement_allocator(const MemoryAllocator *allocator)
+{
+    return dynamic_cast<const PlacementMemoryAllocator *>(allocator);
+}
+
+void write_and_free(const PlacementMemoryAllocator &allocator, size_t sz)
+{
+    auto buf = allocator.alloc(sz);
+    ASSERT_NE(nullptr, buf.get());
+    EXPECT_LE(sz, buf.size());
+    memset(buf.get(), 0x55, sz);
+    allocator.free(buf);
+}
+
+}
+
+TEST(MemoryPlacementTest, placement_can_be_parsed)
+{
+    EXPECT_EQ(MemoryPlacement(), MemoryPlacement::parse(""));
+    EXPECT_EQ(MemoryPlacement(HugePages::NONE, Numa::DEFAULT), MemoryPlacement::parse("nohugepages"));
+    EXPECT_EQ(MemoryPlacement(HugePages::EXPLICIT, Numa::INTERLEAVE), MemoryPlacement::parse("hugetlb,interleave"));
+    EXPECT_EQ(MemoryPlacement(HugePages::TRANSPARENT, Numa::NODE, 1), MemoryPlacement::parse("node=1"));
+    EXPECT_FALSE(MemoryPlacement::parse("hugetlb,bogus").has_value());
+    EXPECT_FALSE(MemoryPlacement::parse("local").has_value());
+    EXPECT_FALSE(MemoryPlacement::parse("node=").has_value());
+    EXPECT_FALSE(MemoryPlacement::parse("node=1x").has_value());
+    EXPECT_FALSE(MemoryPlacement::parse("node=100000").has_value());
+}
+
+TEST(MemoryPlacementTest, placement_can_be_converted_to_string)
+{
+    EXPECT_EQ("thp", MemoryPlacement().to_string());
+    EXPECT_EQ("hugetlb,interleave", MemoryPlacement(HugePages::EXPLICIT, Numa::INTERLEAVE).to_string());
+    EXPECT_EQ("nohugepages,node=3", MemoryPlacement(HugePages::NONE, Numa::NODE, 3).to_string());
+    auto placement = MemoryPlacement(HugePages::NONE, Numa::INTERLEAVE);
+    EXPECT_EQ(placement, MemoryPlacement::parse(placement.to_string()));
+}
+
+TEST(PlacementMemoryAllocatorTest, small_allocations_are_taken_from_heap)
+{
+    PlacementMemoryAllocator allocator(MemoryPlacement(HugePages::EXPLICIT, Numa::INTERLEAVE));
+    write_and_free(allocator, 1000);
+    EXPECT_EQ(0u, allocator.get_stats().allocations);
+}
+
+TEST(PlacementMemoryAllocatorTest, large_allocations_are_placed)
+{
+    constexpr size_t sz = 3 * MemoryAllocator::HUGEPAGE_SIZE + 100;
+    PlacementMemoryAllocator allocator(MemoryPlacement(HugePages::NONE, Numa::NODE, 0));
+    write_and_free(allocator, sz);
+    auto stats = allocator.get_stats();
+    EXPECT_EQ(1u, stats.allocations);
+    EXPECT_EQ(0u, stats.explicit_huge_page_allocations);
+    EXPECT_EQ(0u, stats.huge_page_fallbacks);
+}
+
+TEST(PlacementMemoryAllocatorTest, explicit_huge_pages_fall_back_to_ordinary_pages)
+{
+    constexpr size_t sz = 3 * MemoryAllocator::HUGEPAGE_SIZE + 100;
+    PlacementMemoryAllocator allocator(MemoryPlacement(HugePages::EXPLICIT, Numa::DEFAULT));
+    auto buf = allocator.alloc(sz);
+    EXPECT_EQ(4 * MemoryAllocator::HUGEPAGE_SIZE, buf.size());
+    memset(buf.get(), 0x55, sz);
+    allocator.free(buf.get(), sz);
+    auto stats = allocator.get_stats();
+    EXPECT_EQ(1u, stats.allocations);
+    EXPECT_EQ(1u, stats.explicit_huge_page_allocations + stats.huge_page_fallbacks);
+    EXPECT_EQ(0u, stats.numa_bind_failures);
+}
+
+TEST(PlacementMemoryAllocatorFactoryTest, allocator_is_made_for_configured_kinds)
+{
+    auto &factory = PlacementMemoryAllocatorFactory::instance();
+    factory.setup("tensor:hugetlb,interleave;int64:node=1");
+    EXPECT_FALSE(factory.make_memory_allocator("string"));
+    auto tensor_allocator = factory.make_memory_allocator("tensor");
+    auto int64_allocator = factory.make_memory_allocator("int64");
+    ASSERT_TRUE(as_placement_allocator(tensor_allocator.get()) != nullptr);
+    ASSERT_TRUE(as_placement_allocator(int64_allocator.get()) != nullptr);
+    EXPECT_EQ(MemoryPlacement(HugePages::EXPLICIT, Numa::INTERLEAVE), as_placement_allocator(tensor_allocator.get())->get_placement());
+    EXPECT_EQ(MemoryPlacement(HugePages::TRANSPARENT, Numa::NODE, 1), as_placement_allocator(int64_allocator.get())->get_placement());
+    factory.setup("");
+    EXPECT_FALSE(factory.make_memory_allocator("tensor"));
+}
+
+TEST(PlacementMemoryAllocatorFactoryTest, malformed_spec_is_rejected)
+{
+    auto &factory = PlacementMemoryAllocatorFactory::instance();
+    EXPECT_THROW(factory.setup("tensor"), IllegalArgumentException);
+    EXPECT_THROW(factory.setup("tensor:bogus"), IllegalArgumentException);
+    factory.setup("");
+}
@@ -151,6 +151,13 @@ public:
     bool applyCluster(EntryRef &ref, uint32_t clusterSize, AddIter a, AddIter ae,
                       RemoveIter r, RemoveIter re, CompareT comp);
 
+    /**
+     * Returns true if applying a batch of changes to a tree of the given
+     * size is estimated to be cheaper by building a new tree than by
+     * modifying the existing tree.
+     **/
+    static bool useBuildTree(uint32_t treeSize, size_t additionSize, size_t removeSize) noexcept;
+
     void applyTree(BTreeType *tree, AddIter a, AddIter ae, RemoveIter r, RemoveIter re, CompareT comp);
 
     void normalizeTree(EntryRef &ref, BTreeType *tree, bool wasArray);
@@ -504,6 +504,23 @@ inline uint32_t asmlog2(uint64_t v) noexcept {
 
 }
 
+template <typename KeyT, typename DataT, typename AggrT, typename CompareT,
+          typename TraitsT, typename AggrCalcT>
+bool
+BTreeStore<KeyT, DataT, AggrT, CompareT, TraitsT, AggrCalcT>::
+useBuildTree(uint32_t treeSize, size_t additionSize, size_t removeSize) noexcept
+{
+    uint64_t buildCost = treeSize * 2 + additionSize;
+    uint64_t modifyCost = (asmlog2(treeSize + additionSize) + 1) *
+                          (additionSize + removeSize);
+    // Each leaf node touched by repeated insertions is copied when the tree is frozen,
+    // making a rebuild cheaper for large batches spread over the tree.
+    uint64_t touchedLeaves = std::min(static_cast<uint64_t>(additionSize + removeSize),
+                                      static_cast<uint64_t>(treeSize / LeafNodeType::maxSlots() + 1));
+    modifyCost += touchedLeaves * LeafNodeType::maxSlots();
+    return modifyCost >= buildCost;
+}
+
 template <typename KeyT, typename DataT, typename AggrT, typename CompareT,
           typename TraitsT, typename AggrCalcT>
 void
@@ -517,15 +534,10 @@ applyTree(BTreeType *tree,
 {
     // Old data was tree or has been converted to a tree
     uint32_t treeSize = tree->size(_allocator);
-    size_t additionSize(ae - a);
-    size_t removeSize(re - r);
-    uint64_t buildCost = treeSize * 2 + additionSize;
-    uint64_t modifyCost = (asmlog2(treeSize + additionSize) + 1) *
-                          (additionSize + removeSize);
-    if (modifyCost < buildCost)
-        applyModifyTree(tree, a, ae, r, re, comp);
-    else
+    if (useBuildTree(treeSize, ae - a, re - r))
         applyBuildTree(tree, a, ae, r, re, comp);
+    else
+        applyModifyTree(tree, a, ae, r, re, comp);
 }
 
 
@@ -3,6 +3,7 @@
 #include "compaction_context.h"
 #include "compacting_buffers.h"
 #include "i_compactable.h"
+#include <algorithm>
 
 namespace vespalib::datastore {
 
@@ -10,7 +11,8 @@ CompactionContext::CompactionContext(ICompactable& store,
                                      std::unique_ptr<CompactingBuffers> compacting_buffers)
     : _store(store),
       _compacting_buffers(std::move(compacting_buffers)),
-      _filter(_compacting_buffers->make_entry_ref_filter())
+      _filter(_compacting_buffers->make_entry_ref_filter()),
+      _next(0)
 {
 }
 
@@ -31,4 +33,15 @@ CompactionContext::compact(std::span<AtomicEntryRef> refs)
     }
 }
 
+bool
+CompactionContext::compact_step(std::span<AtomicEntryRef> refs, size_t max_refs)
+{
+    size_t end = (max_refs != 0) ? std::min(refs.size(), _next + max_refs) : refs.size();
+    if (_next < end) {
+        compact(refs.subspan(_next, end - _next));
+        _next = end;
+    }
+    return _next >= refs.size();
+}
+
 }
@@ -31,6 +31,7 @@ std::ostream& operator<<(std::ostream& os, const CompactionStrategy& compaction_
 {
     os << "{maxDeadBytesRatio=" << compaction_strategy.getMaxDeadBytesRatio() <<
         ", maxDeadAddressSpaceRatio=" << compaction_strategy.getMaxDeadAddressSpaceRatio() <<
+        ", compactionStepSize=" << compaction_strategy.get_compaction_step_size() <<
         "}";
     return os;
 }
@@ -30,6 +30,7 @@ private:
     float _maxDeadAddressSpaceRatio; // Max ratio of dead address space before compaction
     float _active_buffers_ratio; // Ratio of active buffers to compact for each reason (memory usage, address space usage)
     uint32_t _max_buffers; // Max number of buffers to compact for each reason (memory usage, address space usage)
+    uint32_t _compaction_step_size; // Max number of refs to move per compaction step, 0 means no limit
     bool should_compact_memory(size_t used_bytes, size_t dead_bytes) const noexcept {
         return ((dead_bytes >= DEAD_BYTES_SLACK) &&
                 (dead_bytes > used_bytes * getMaxDeadBytesRatio()));
@@ -43,29 +44,42 @@ public:
         : _maxDeadBytesRatio(0.05),
           _maxDeadAddressSpaceRatio(0.2),
           _active_buffers_ratio(0.1),
-          _max_buffers(1)
+          _max_buffers(1),
+          _compaction_step_size(0)
     { }
     CompactionStrategy(float maxDeadBytesRatio, float maxDeadAddressSpaceRatio) noexcept
         : _maxDeadBytesRatio(maxDeadBytesRatio),
           _maxDeadAddressSpaceRatio(maxDeadAddressSpaceRatio),
           _active_buffers_ratio(0.1),
-          _max_buffers(1)
+          _max_buffers(1),
+          _compaction_step_size(0)
     { }
     CompactionStrategy(float maxDeadBytesRatio, float maxDeadAddressSpaceRatio, uint32_t max_buffers, float active_buffers_ratio) noexcept
+        : CompactionStrategy(maxDeadBytesRatio, maxDeadAddressSpaceRatio, max_buffers, active_buffers_ratio, 0)
+    { }
+    CompactionStrategy(float maxDeadBytesRatio, float maxDeadAddressSpaceRatio, uint32_t max_buffers, float active_buffers_ratio,
+                       uint32_t compaction_step_size) noexcept
         : _maxDeadBytesRatio(maxDeadBytesRatio),
           _maxDeadAddressSpaceRatio(maxDeadAddressSpaceRatio),
           _active_buffers_ratio(active_buffers_ratio),
-          _max_buffers(max_buffers)
+          _max_buffers(max_buffers),
+          _compaction_step_size(compaction_step_size)
     { }
     double getMaxDeadBytesRatio() const noexcept { return _maxDeadBytesRatio; }
     double getMaxDeadAddressSpaceRatio() const noexcept { return _maxDeadAddressSpaceRatio; }
     uint32_t get_max_buffers() const noexcept { return _max_buffers; }
     double get_active_buffers_ratio() const noexcept { return _active_buffers_ratio; }
+    /*
+     * Max number of refs moved per compaction step for data stores where compaction can be
+     * spread over several commits (see ICompactionContext::compact_step), 0 means no limit.
+     */
+    uint32_t get_compaction_step_size() const noexcept { return _compaction_step_size; }
     bool operator==(const CompactionStrategy & rhs) const noexcept {
         return (_maxDeadBytesRatio == rhs._maxDeadBytesRatio) &&
             (_maxDeadAddressSpaceRatio == rhs._maxDeadAddressSpaceRatio) &&
             (_max_buffers == rhs._max_buffers) &&
-            (_active_buffers_ratio == rhs._active_buffers_ratio);
+            (_active_buffers_ratio == rhs._active_buffers_ratio) &&
+            (_compaction_step_size == rhs._compaction_step_size);
     }
     bool operator!=(const CompactionStrategy & rhs) const noexcept { return !(operator==(rhs)); }
 
@@ -18,6 +18,19 @@ struct ICompactionContext {
     using UP = std::unique_ptr<ICompactionContext>;
     virtual ~ICompactionContext() {}
     virtual void compact(std::span<AtomicEntryRef> refs) = 0;
+    /*
+     * Compacts at most max_refs of the given refs (0 means no limit), continuing after the
+     * refs handled by the previous call. Returns true when all refs have been handled. This
+     * lets the writer spread a large compaction over several steps, interleaved with other
+     * updates. Refs added or changed after the compaction started never point to the
+     * compacting buffers, so the refs can grow between steps. That does not hold for unique
+     * stores, where adding an existing value gives a ref to the already stored entry.
+     */
+    virtual bool compact_step(std::span<AtomicEntryRef> refs, size_t max_refs) {
+        (void) max_refs;
+        compact(refs);
+        return true;
+    }
 };
 
 }
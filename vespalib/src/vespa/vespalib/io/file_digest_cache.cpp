@@ -0,0 +1,23 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "file_digest_cache.h"
+#include <sys/stat.h>
+
+namespace vespalib {
+
+std::optional<FileStamp>
+FileStamp::of(const std::string &path)
+{
+    struct ::stat info;
+    if (::stat(path.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) {
+        return std::nullopt;
+    }
+#ifdef __APPLE__
+    uint64_t mtime_ns = uint64_t(info.st_mtimespec.tv_sec) * 1000000000ul + info.st_mtimespec.tv_nsec;
+#else
+    uint64_t mtime_ns = uint64_t(info.st_mtim.tv_sec) * 1000000000ul + info.st_mtim.tv_nsec;
+#endif
+    return FileStamp{size_t(info.st_size), mtime_ns};
+}
+
+} // namespace vespalib
@@ -0,0 +1,84 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "mapped_file_input.h"
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace vespalib {
+
+/**
+ * Size and modification time of a file, used to detect that a file
+ * has changed without reading it.
+ **/
+struct FileStamp {
+    size_t   size;
+    uint64_t mtime_ns;
+    bool operator==(const FileStamp &rhs) const noexcept = default;
+    // Returns nullopt if the file cannot be stat'ed.
+    static std::optional<FileStamp> of(const std::string &path);
+};
+
+/**
+ * Memoizes a digest (e.g. a content hash) calculated from the content
+ * of files, keyed by path and revalidated by file stamp. Used to avoid
+ * mapping and hashing large files each time they are looked up. A
+ * digest is only memoized when the file did not change while being
+ * read. The cache is cleared when it reaches max_entries.
+ **/
+template <typename Digest>
+class FileDigestCache {
+public:
+    using Calc = std::function<Digest(Memory content)>;
+private:
+    struct Entry {
+        FileStamp stamp;
+        Digest    digest;
+    };
+    Calc                         _calc;
+    size_t                       _max_entries;
+    std::mutex                   _lock;
+    std::map<std::string, Entry> _entries;
+public:
+    explicit FileDigestCache(Calc calc, size_t max_entries = 1024)
+        : _calc(std::move(calc)), _max_entries(max_entries), _lock(), _entries() {}
+    // Returns nullopt if the file cannot be read or is empty.
+    std::optional<Digest> get(const std::string &path) {
+        auto stamp = FileStamp::of(path);
+        if (!stamp.has_value() || stamp->size == 0) {
+            return std::nullopt;
+        }
+        {
+            std::lock_guard guard(_lock);
+            auto pos = _entries.find(path);
+            if (pos != _entries.end() && pos->second.stamp == stamp.value()) {
+                return pos->second.digest;
+            }
+        }
+        // calculating the digest of large files takes a while; do it without locking
+        MappedFileInput file(path);
+        if (!file.valid() || file.get().size == 0) {
+            return std::nullopt;
+        }
+        Digest digest = _calc(file.get());
+        if (FileStamp::of(path) == stamp) {
+            std::lock_guard guard(_lock);
+            if (_entries.size() >= _max_entries) {
+                _entries.clear();
+            }
+            _entries.insert_or_assign(path, Entry{stamp.value(), digest});
+        }
+        return digest;
+    }
+    size_t size() {
+        std::lock_guard guard(_lock);
+        return _entries.size();
+    }
+};
+
+} // namespace vespalib
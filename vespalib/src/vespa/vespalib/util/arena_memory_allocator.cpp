@@ -0,0 +1,90 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "arena_memory_allocator.h"
+#include "exceptions.h"
+#include "stringfmt.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace vespalib::alloc {
+
+ArenaMemoryAllocator::ArenaMemoryAllocator(size_t retain_limit) noexcept
+    : _blocks(),
+      _used(0),
+      _next_block_size(MIN_BLOCK_SIZE),
+      _retain_limit(retain_limit),
+      _allocations(0),
+      _block_allocations(0)
+{
+}
+
+ArenaMemoryAllocator::~ArenaMemoryAllocator()
+{
+    for (const Block &block: _blocks) {
+        ::free(block.mem);
+    }
+}
+
+char *
+ArenaMemoryAllocator::alloc_block(size_t sz) const
+{
+    void *mem = malloc(sz);
+    if (mem == nullptr) {
+        throw OOMException(make_string("malloc(%zu) failed for arena block", sz));
+    }
+    ++_block_allocations;
+    return static_cast<char *>(mem);
+}
+
+PtrAndSize
+ArenaMemoryAllocator::alloc(size_t sz) const
+{
+    if (sz == 0) {
+        return {};
+    }
+    size_t aligned = (sz + (ALIGNMENT - 1)) & ~(ALIGNMENT - 1);
+    if (_blocks.empty() || ((_used + aligned) > _blocks.back().size)) {
+        size_t block_size = std::max(aligned, _next_block_size);
+        _blocks.push_back(Block{alloc_block(block_size), block_size});
+        _next_block_size = 2 * block_size;
+        _used = 0;
+    }
+    char *ptr = _blocks.back().mem + _used;
+    _used += aligned;
+    ++_allocations;
+    return {ptr, sz};
+}
+
+void
+ArenaMemoryAllocator::reset()
+{
+    size_t total = capacity();
+    if ((_blocks.size() > 1) || (total > _retain_limit)) {
+        for (const Block &block: _blocks) {
+            ::free(block.mem);
+        }
+        _blocks.clear();
+        _next_block_size = (total > _retain_limit) ? MIN_BLOCK_SIZE : total;
+    }
+    _used = 0;
+}
+
+size_t
+ArenaMemoryAllocator::capacity() const noexcept
+{
+    size_t total = 0;
+    for (const Block &block: _blocks) {
+        total += block.size;
+    }
+    return total;
+}
+
+MemoryUsage
+ArenaMemoryAllocator::get_memory_usage() const noexcept
+{
+    size_t allocated = capacity();
+    size_t used = _blocks.empty() ? 0 : (allocated - _blocks.back().size + _used);
+    return {allocated, used, 0, 0};
+}
+
+}
@@ -0,0 +1,57 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "memory_allocator.h"
+#include "memoryusage.h"
+#include <vector>
+
+namespace vespalib::alloc {
+
+/*
+ * Allocator handing out memory from a list of large blocks by bumping
+ * a pointer. Freeing memory is a no-op; all memory is made available
+ * again by calling reset, after which earlier allocations must no
+ * longer be used. When more than one block was needed since the last
+ * reset, the blocks are replaced by a single block large enough for
+ * all of them on the next allocation. A repeated workload will thus
+ * run without heap allocations after the first round. When the
+ * blocks add up to more than the retain limit, they are released on
+ * reset, so at most retain limit bytes are kept between rounds. Not
+ * thread safe.
+ */
+class ArenaMemoryAllocator : public MemoryAllocator {
+public:
+    static constexpr size_t ALIGNMENT = alignof(std::max_align_t);
+    static constexpr size_t MIN_BLOCK_SIZE = 16_Ki;
+    static constexpr size_t DEFAULT_RETAIN_LIMIT = 256_Ki;
+    struct Stats {
+        size_t allocations;       // allocations served by the arena
+        size_t block_allocations; // allocations made by the arena itself
+    };
+    explicit ArenaMemoryAllocator(size_t retain_limit) noexcept;
+    ArenaMemoryAllocator() noexcept : ArenaMemoryAllocator(DEFAULT_RETAIN_LIMIT) {}
+    ~ArenaMemoryAllocator() override;
+    PtrAndSize alloc(size_t sz) const override;
+    void free(PtrAndSize) const noexcept override {}
+    size_t resize_inplace(PtrAndSize, size_t) const override { return 0; }
+    void reset();
+    size_t capacity() const noexcept;
+    MemoryUsage get_memory_usage() const noexcept;
+    Stats get_stats() const noexcept { return {_allocations, _block_allocations}; }
+private:
+    struct Block {
+        char   *mem;
+        size_t  size;
+    };
+    char *alloc_block(size_t sz) const;
+
+    mutable std::vector<Block> _blocks;
+    mutable size_t             _used;
+    mutable size_t             _next_block_size;
+    size_t                     _retain_limit;
+    mutable size_t             _allocations;
+    mutable size_t             _block_allocations;
+};
+
+}
@@ -0,0 +1,241 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "placement_memory_allocator.h"
+#include "exceptions.h"
+#include "round_up_to_page_size.h"
+#include "stringfmt.h"
+#include <charconv>
+#include <cstdlib>
+#include <fstream>
+#include <sys/mman.h>
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include <vector>
+
+namespace vespalib::alloc {
+
+namespace {
+
+constexpr size_t max_numa_nodes = 1024;
+constexpr size_t bits_per_word = 8 * sizeof(unsigned long);
+
+/*
+ * Returns the mask of online numa nodes, e.g. "0-1,3" in sysfs, or an empty
+ * vector if it is not available.
+ */
+std::vector<unsigned long>
+make_online_nodes_mask()
+{
+    std::ifstream file("/sys/devices/system/node/online");
+    std::string line;
+    if (!std::getline(file, line) || line.empty()) {
+        return {};
+    }
+    std::vector<unsigned long> mask(max_numa_nodes / bits_per_word, 0);
+    size_t pos = 0;
+    while (pos < line.size()) {
+        size_t end = line.find(',', pos);
+        if (end == std::string::npos) {
+            end = line.size();
+        }
+        std::string range = line.substr(pos, end - pos);
+        size_t dash = range.find('-');
+        size_t first = 0;
+        size_t last = 0;
+        try {
+            first = std::stoul(range.substr(0, dash));
+            last = (dash == std::string::npos) ? first : std::stoul(range.substr(dash + 1));
+        } catch (const std::exception &) {
+            return {};
+        }
+        for (size_t node = first; node <= last && node < max_numa_nodes; ++node) {
+            mask[node / bits_per_word] |= (1ul << (node % bits_per_word));
+        }
+        pos = end + 1;
+    }
+    return mask;
+}
+
+const std::vector<unsigned long> &
+online_nodes_mask()
+{
+    static const std::vector<unsigned long> mask = make_online_nodes_mask();
+    return mask;
+}
+
+}
+
+std::string
+MemoryPlacement::to_string() const
+{
+    std::string result;
+    switch (huge_pages) {
+    case HugePages::TRANSPARENT: result = "thp"; break;
+    case HugePages::NONE: result = "nohugepages"; break;
+    case HugePages::EXPLICIT: result = "hugetlb"; break;
+    }
+    switch (numa) {
+    case Numa::DEFAULT: break;
+    case Numa::INTERLEAVE: result += ",interleave"; break;
+    case Numa::NODE: result += make_string(",node=%u", numa_node); break;
+    }
+    return result;
+}
+
+std::optional<MemoryPlacement>
+MemoryPlacement::parse(std::string_view spec)
+{
+    MemoryPlacement result;
+    while (!spec.empty()) {
+        size_t end = spec.find(',');
+        std::string_view option = spec.substr(0, end);
+        spec = (end == std::string_view::npos) ? std::string_view() : spec.substr(end + 1);
+        if (option == "thp") {
+            result.huge_pages = HugePages::TRANSPARENT;
+        } else if (option == "nohugepages") {
+            result.huge_pages = HugePages::NONE;
+        } else if (option == "hugetlb") {
+            result.huge_pages = HugePages::EXPLICIT;
+        } else if (option == "interleave") {
+            result.numa = Numa::INTERLEAVE;
+        } else if (option.starts_with("node=")) {
+            std::string_view node = option.substr(5);
+            uint32_t numa_node = 0;
+            auto [ptr, ec] = std::from_chars(node.data(), node.data() + node.size(), numa_node);
+            if (node.empty() || ec != std::errc() || ptr != node.data() + node.size() || numa_node >= max_numa_nodes) {
+                return std::nullopt;
+            }
+            result.numa = Numa::NODE;
+            result.numa_node = numa_node;
+        } else {
+            return std::nullopt;
+        }
+    }
+    return result;
+}
+
+PlacementMemoryAllocator::PlacementMemoryAllocator(MemoryPlacement placement)
+    : _placement(placement),
+      _allocations(0),
+      _explicit_huge_page_allocations(0),
+      _huge_page_fallbacks(0),
+      _numa_bind_failures(0)
+{
+}
+
+PlacementMemoryAllocator::~PlacementMemoryAllocator() = default;
+
+size_t
+PlacementMemoryAllocator::round_up(size_t sz) const noexcept
+{
+    return (_placement.huge_pages == MemoryPlacement::HugePages::EXPLICIT)
+        ? roundUpToHugePages(sz)
+        : round_up_to_page_size(sz);
+}
+
+void
+PlacementMemoryAllocator::bind_numa(void * buf, size_t sz) const noexcept
+{
+#ifdef __linux__
+    long retval = 0;
+    if (_placement.numa == MemoryPlacement::Numa::INTERLEAVE) {
+        const auto &mask = online_nodes_mask();
+        retval = mask.empty()
+            ? -1
+            : syscall(SYS_mbind, buf, sz, MPOL_INTERLEAVE, mask.data(), mask.size() * bits_per_word + 1, 0);
+    } else if (_placement.numa == MemoryPlacement::Numa::NODE) {
+        std::vector<unsigned long> mask(max_numa_nodes / bits_per_word, 0);
+        mask[_placement.numa_node / bits_per_word] |= (1ul << (_placement.numa_node % bits_per_word));
+        retval = syscall(SYS_mbind, buf, sz, MPOL_PREFERRED, mask.data(), mask.size() * bits_per_word + 1, 0);
+    }
+    if (retval != 0) {
+        _numa_bind_failures.fetch_add(1, std::memory_order_relaxed);
+    }
+#else
+    (void) buf;
+    (void) sz;
+    if (_placement.numa != MemoryPlacement::Numa::DEFAULT) {
+        _numa_bind_failures.fetch_add(1, std::memory_order_relaxed);
+    }
+#endif
+}
+
+PtrAndSize
+PlacementMemoryAllocator::alloc(size_t sz) const
+{
+    if (sz == 0) {
+        return {};
+    }
+    if (sz < HUGEPAGE_SIZE) {
+        // Placement is only worthwhile for large buffers.
+        void * buf = malloc(sz);
+        if (buf == nullptr) {
+            throw OOMException(make_string("malloc(%zu) failed", sz));
+        }
+        return {buf, sz};
+    }
+    sz = round_up(sz);
+    const int flags(MAP_ANON | MAP_PRIVATE);
+    const int prot(PROT_READ | PROT_WRITE);
+    void * buf = MAP_FAILED;
+#ifdef __linux__
+    if (_placement.huge_pages == MemoryPlacement::HugePages::EXPLICIT) {
+        buf = mmap(nullptr, sz, prot, flags | MAP_HUGETLB, -1, 0);
+        if (buf != MAP_FAILED) {
+            _explicit_huge_page_allocations.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            _huge_page_fallbacks.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+#endif
+    bool explicit_huge_pages = (buf != MAP_FAILED);
+    if (!explicit_huge_pages) {
+        buf = mmap(nullptr, sz, prot, flags, -1, 0);
+        if (buf == MAP_FAILED) {
+            throw OOMException(make_string("Failed mmaping anonymous of size %zu errno(%d)", sz, errno));
+        }
+    }
+#ifdef __linux__
+    if (!explicit_huge_pages) {
+        int advice = (_placement.huge_pages == MemoryPlacement::HugePages::NONE) ? MADV_NOHUGEPAGE : MADV_HUGEPAGE;
+        if (madvise(buf, sz, advice) != 0) {
+            // Just an advise, not everyone will listen...
+        }
+    }
+#endif
+    if (_placement.numa != MemoryPlacement::Numa::DEFAULT) {
+        bind_numa(buf, sz);
+    }
+    _allocations.fetch_add(1, std::memory_order_relaxed);
+    return {buf, sz};
+}
+
+void
+PlacementMemoryAllocator::free(PtrAndSize alloc) const noexcept
+{
+    if (alloc.size() >= HUGEPAGE_SIZE) {
+        munmap(alloc.get(), alloc.size());
+    } else if (alloc.size() != 0) {
+        ::free(alloc.get());
+    }
+}
+
+void
+PlacementMemoryAllocator::free(void * ptr, size_t sz) const noexcept
+{
+    free(PtrAndSize(ptr, (sz >= HUGEPAGE_SIZE) ? round_up(sz) : sz));
+}
+
+PlacementMemoryAllocator::Stats
+PlacementMemoryAllocator::get_stats() const noexcept
+{
+    return {_allocations.load(std::memory_order_relaxed),
+            _explicit_huge_page_allocations.load(std::memory_order_relaxed),
+            _huge_page_fallbacks.load(std::memory_order_relaxed),
+            _numa_bind_failures.load(std::memory_order_relaxed)};
+}
+
+}
@@ -0,0 +1,83 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "memory_allocator.h"
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace vespalib::alloc {
+
+/*
+ * Wanted placement of memory backing large buffers.
+ */
+struct MemoryPlacement {
+    enum class HugePages : uint8_t {
+        TRANSPARENT, // madvise(MADV_HUGEPAGE), as for ordinary mmap allocations
+        NONE,        // madvise(MADV_NOHUGEPAGE)
+        EXPLICIT     // mmap with MAP_HUGETLB, falling back to transparent huge pages
+    };
+    enum class Numa : uint8_t {
+        DEFAULT,     // the policy of the allocating thread
+        INTERLEAVE,  // pages interleaved over all online nodes
+        NODE         // pages preferably placed on numa_node, falling back to other nodes when it is full
+    };
+    HugePages huge_pages;
+    Numa      numa;
+    uint32_t  numa_node; // only used for Numa::NODE
+
+    constexpr MemoryPlacement() noexcept : huge_pages(HugePages::TRANSPARENT), numa(Numa::DEFAULT), numa_node(0) {}
+    constexpr MemoryPlacement(HugePages huge_pages_in, Numa numa_in, uint32_t numa_node_in = 0) noexcept
+        : huge_pages(huge_pages_in),
+          numa(numa_in),
+          numa_node(numa_node_in)
+    {}
+    bool operator==(const MemoryPlacement &rhs) const noexcept = default;
+    std::string to_string() const;
+    /*
+     * Parses a comma separated list of options among "thp", "nohugepages", "hugetlb",
+     * "interleave" and "node=<n>". Returns nullopt if an option is unknown or the
+     * node number is invalid. There is deliberately no option for placing pages on
+     * the node of the thread first touching them, since that is what the kernel
+     * does by default.
+     */
+    static std::optional<MemoryPlacement> parse(std::string_view spec);
+};
+
+/*
+ * Allocator using anonymous memory mappings placed according to a
+ * MemoryPlacement. Allocations smaller than a huge page are taken from the
+ * heap. Counters for the effective placement are kept, since both explicit
+ * huge pages and numa binding are requests the kernel may refuse.
+ */
+class PlacementMemoryAllocator : public MemoryAllocator {
+public:
+    struct Stats {
+        size_t allocations;
+        size_t explicit_huge_page_allocations;
+        size_t huge_page_fallbacks;
+        size_t numa_bind_failures;
+    };
+    explicit PlacementMemoryAllocator(MemoryPlacement placement);
+    ~PlacementMemoryAllocator() override;
+    PtrAndSize alloc(size_t sz) const override;
+    void free(PtrAndSize alloc) const noexcept override;
+    void free(void * ptr, size_t sz) const noexcept override;
+    size_t resize_inplace(PtrAndSize, size_t) const override { return 0; }
+    const MemoryPlacement& get_placement() const noexcept { return _placement; }
+    Stats get_stats() const noexcept;
+private:
+    size_t round_up(size_t sz) const noexcept;
+    void bind_numa(void * buf, size_t sz) const noexcept;
+
+    MemoryPlacement             _placement;
+    mutable std::atomic<size_t> _allocations;
+    mutable std::atomic<size_t> _explicit_huge_page_allocations;
+    mutable std::atomic<size_t> _huge_page_fallbacks;
+    mutable std::atomic<size_t> _numa_bind_failures;
+};
+
+}
@@ -0,0 +1,72 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "placement_memory_allocator_factory.h"
+#include "exceptions.h"
+#include "stringfmt.h"
+#include <cstdlib>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".vespalib.util.placement_memory_allocator_factory");
+
+namespace vespalib::alloc {
+
+PlacementMemoryAllocatorFactory::PlacementMemoryAllocatorFactory()
+    : _lock(),
+      _placements()
+{
+    const char * spec = getenv("VESPA_MEMORY_PLACEMENT");
+    if (spec != nullptr) {
+        try {
+            setup(spec);
+        } catch (const IllegalArgumentException &e) {
+            LOG(warning, "Ignoring VESPA_MEMORY_PLACEMENT='%s', using default placement: %s", spec, e.getMessage().c_str());
+        }
+    }
+}
+
+PlacementMemoryAllocatorFactory::~PlacementMemoryAllocatorFactory() = default;
+
+void
+PlacementMemoryAllocatorFactory::setup(const std::string& spec)
+{
+    std::map<std::string, MemoryPlacement> placements;
+    size_t pos = 0;
+    while (pos < spec.size()) {
+        size_t end = spec.find(';', pos);
+        if (end == std::string::npos) {
+            end = spec.size();
+        }
+        std::string entry = spec.substr(pos, end - pos);
+        size_t colon = entry.find(':');
+        auto placement = (colon != std::string::npos)
+            ? MemoryPlacement::parse(std::string_view(entry).substr(colon + 1))
+            : std::nullopt;
+        if (!placement.has_value() || colon == 0) {
+            throw IllegalArgumentException(make_string("Malformed memory placement '%s'", entry.c_str()));
+        }
+        placements[entry.substr(0, colon)] = placement.value();
+        pos = end + 1;
+    }
+    std::lock_guard guard(_lock);
+    _placements = std::move(placements);
+}
+
+std::unique_ptr<MemoryAllocator>
+PlacementMemoryAllocatorFactory::make_memory_allocator(const std::string& kind) const
+{
+    std::lock_guard guard(_lock);
+    auto itr = _placements.find(kind);
+    if (itr == _placements.end()) {
+        return {};
+    }
+    return std::make_unique<PlacementMemoryAllocator>(itr->second);
+}
+
+PlacementMemoryAllocatorFactory&
+PlacementMemoryAllocatorFactory::instance()
+{
+    static PlacementMemoryAllocatorFactory instance;
+    return instance;
+}
+
+}
@@ -0,0 +1,41 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "placement_memory_allocator.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace vespalib::alloc {
+
+/*
+ * Class for creating placement memory allocators for the kinds of data
+ * structures (e.g. attribute types) that have a memory placement configured.
+ *
+ * The placements are given as a semicolon separated list of
+ * "<kind>:<placement>", e.g. "tensor:hugetlb,interleave;int64:node=1", see
+ * MemoryPlacement::parse(). They are initially taken from the environment
+ * variable VESPA_MEMORY_PLACEMENT.
+ */
+class PlacementMemoryAllocatorFactory {
+    mutable std::mutex                     _lock;
+    std::map<std::string, MemoryPlacement> _placements;
+
+    PlacementMemoryAllocatorFactory();
+    ~PlacementMemoryAllocatorFactory();
+    PlacementMemoryAllocatorFactory(const PlacementMemoryAllocatorFactory &) = delete;
+    PlacementMemoryAllocatorFactory& operator=(const PlacementMemoryAllocatorFactory &) = delete;
+public:
+    /*
+     * Replaces the configured placements. Throws IllegalArgumentException if the spec is malformed.
+     */
+    void setup(const std::string& spec);
+    // Returns nullptr if no placement is configured for the given kind.
+    std::unique_ptr<MemoryAllocator> make_memory_allocator(const std::string& kind) const;
+
+    static PlacementMemoryAllocatorFactory& instance();
+};
+
+}